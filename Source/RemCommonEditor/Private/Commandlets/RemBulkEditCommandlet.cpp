@@ -0,0 +1,73 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+
+#include "Commandlets/RemBulkEditCommandlet.h"
+
+#include "RemBulkEdit.h"
+#include "RemCommonEditorLog.h"
+#include "AssetRegistry/IAssetRegistry.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RemBulkEditCommandlet)
+
+URemBulkEditCommandlet::URemBulkEditCommandlet()
+{
+    IsClient        = false;
+    IsEditor        = true;
+    IsServer        = false;
+    LogToConsole    = true;
+    HelpDescription = TEXT("Set a property of all objects in the assets under some content paths");
+    HelpUsage       = TEXT("-run=RemBulkEdit -Paths=/Game/A+/Game/B -Property=Struct.Member -Match=Old -Replace=New "
+        "[-BatchSize=64] [-DryRun]");
+}
+
+int32 URemBulkEditCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamValues;
+    ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+    FRemBulkEditRequest Request;
+
+    const FString* Paths            = ParamValues.Find(TEXT("Paths"));
+    const FString* PropertyPath     = ParamValues.Find(TEXT("Property"));
+    const FString* ReplacementValue = ParamValues.Find(TEXT("Replace"));
+    if (!Paths || !PropertyPath || !ReplacementValue)
+    {
+        UE_LOG(LogRemCommonEditor, Error, TEXT("Missing parameters, usage: %s"), *HelpUsage);
+        return 1;
+    }
+
+    TArray<FString> PackagePaths;
+    Paths->ParseIntoArray(PackagePaths, TEXT("+"));
+    for (const auto& PackagePath : PackagePaths)
+    {
+        Request.PackagePaths.Add(FName{PackagePath});
+    }
+
+    Request.PropertyPath     = *PropertyPath;
+    Request.ReplacementValue = *ReplacementValue;
+
+    if (const FString* MatchValue = ParamValues.Find(TEXT("Match")))
+    {
+        Request.MatchValue = *MatchValue;
+    }
+
+    if (const FString* BatchSize = ParamValues.Find(TEXT("BatchSize")))
+    {
+        LexFromString(Request.BatchSize, **BatchSize);
+    }
+
+    Request.bDryRun = Switches.Contains(TEXT("DryRun"));
+
+    // commandlets don't gather assets on their own
+    IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+    const auto Result = Rem::CommonEditor::BulkEditProperties(Request);
+
+    UE_LOG(LogRemCommonEditor, Display,
+        TEXT("Bulk edit finished in %.2fs, %d packages loaded, %d objects edited, %d packages saved"), Result.Seconds,
+        Result.NumPackagesLoaded, Result.NumObjectsEdited, Result.NumPackagesSaved);
+
+    return Result.bSucceeded ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+
+#include "Commandlets/RemFunctionReferenceValidationCommandlet.h"
+
+#include "RemCommonEditorLog.h"
+#include "RemFunctionReferenceValidation.h"
+#include "AssetRegistry/IAssetRegistry.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RemFunctionReferenceValidationCommandlet)
+
+URemFunctionReferenceValidationCommandlet::URemFunctionReferenceValidationCommandlet()
+{
+    IsClient        = false;
+    IsEditor        = true;
+    IsServer        = false;
+    LogToConsole    = true;
+    HelpDescription = TEXT("Find FRemReflectedFunctionData whose function no longer exists on its owner class");
+    HelpUsage       = TEXT("-run=RemFunctionReferenceValidation [-Paths=/Game/A+/Game/B] [-BatchSize=64] [-NoCache]");
+}
+
+int32 URemFunctionReferenceValidationCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamValues;
+    ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+    TArray<FName> PackagePaths;
+    if (const FString* Paths = ParamValues.Find(TEXT("Paths")))
+    {
+        TArray<FString> PathStrings;
+        Paths->ParseIntoArray(PathStrings, TEXT("+"));
+        for (const auto& PathString : PathStrings)
+        {
+            PackagePaths.Add(FName{PathString});
+        }
+    }
+    else
+    {
+        PackagePaths.Add(FName{TEXTVIEW("/Game")});
+    }
+
+    int32 BatchSize{64};
+    if (const FString* BatchSizeString = ParamValues.Find(TEXT("BatchSize")))
+    {
+        LexFromString(BatchSize, **BatchSizeString);
+    }
+
+    // commandlets don't gather assets on their own
+    IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+    const auto Result = Rem::CommonEditor::ScanStaleFunctionReferences(PackagePaths, BatchSize,
+        !Switches.Contains(TEXT("NoCache")));
+
+    int32 NumIssues{};
+    for (const auto& [PackageName, Issues] : Result.Issues)
+    {
+        for (const auto& Issue : Issues)
+        {
+            UE_LOG(LogRemCommonEditor, Error, TEXT("%s"), *Issue);
+        }
+        NumIssues += Issues.Num();
+    }
+
+    UE_LOG(LogRemCommonEditor, Display,
+        TEXT("Found %d stale function references in %.2fs, %d/%d packages checked, the rest are unchanged"),
+        NumIssues, Result.Seconds, Result.NumPackagesChecked, Result.NumPackagesFound);
+
+    return NumIssues > 0 ? 1 : 0;
+}
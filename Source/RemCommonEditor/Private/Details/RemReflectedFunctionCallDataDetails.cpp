@@ -7,19 +7,81 @@
 #include "IDetailChildrenBuilder.h"
 #include "PropertyCustomizationHelpers.h"
 #include "PropertyRestriction.h"
+#include "RemCommonEditorStat.h"
+#include "RemEditorUtilitiesMemReport.h"
 #include "RemEditorUtilitiesStatics.inl"
+#include "RemFunctionOwnerClassIndex.h"
+#include "RemFunctionSignatureCache.h"
 #include "ClassFilter/RemEditorUtilitiesClassFilter.h"
 #include "Macro/RemAssertionMacros.h"
 #include "Struct/RemReflectedFunctionCallData.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Macro/RemLogMacros.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/StringBuilder.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
+namespace
+{
+TAutoConsoleVariable CVarHideClassesWithoutFunctions(TEXT("Rem.Editor.FunctionOwnerClass.HideClassesWithoutFunctions"),
+    true, TEXT("Hide classes without any supported function from the class picker of FunctionOwnerClass"));
+
+/** customizations are made and destroyed on game thread only */
+int32 NumLiveInstances{};
+
+/** restrictions made for FunctionOwnerClass, which should go away along with the details view */
+int32 NumLiveRestrictions{};
+
+/**
+ * @brief Class filter of the restriction made for FunctionOwnerClass, each restriction owns one,
+ * so live filters are live restrictions
+ */
+struct FFunctionOwnerClassFilter final : FRemEditorUtilitiesClassFilter
+{
+    FFunctionOwnerClassFilter()
+    {
+        ++NumLiveRestrictions;
+    }
+
+    virtual ~FFunctionOwnerClassFilter() override
+    {
+        --NumLiveRestrictions;
+    }
+};
+
+FName MakeMemberPath(const FAnsiStringView OuterMemberName, const FAnsiStringView MemberName)
+{
+    TStringBuilder<128> MemberPath;
+    MemberPath << OuterMemberName << TEXT('.') << MemberName;
+
+    return FName{MemberPath.Len(), MemberPath.GetData()};
+}
+}
+
+FRemReflectedFunctionCallDataDetails::FRemReflectedFunctionCallDataDetails()
+{
+    ++NumLiveInstances;
+}
+
+FRemReflectedFunctionCallDataDetails::~FRemReflectedFunctionCallDataDetails()
+{
+    --NumLiveInstances;
+}
+
 TSharedRef<IPropertyTypeCustomization> FRemReflectedFunctionCallDataDetails::MakeInstance()
 {
+    LLM_SCOPE_BYTAG(RemCommonEditor);
+
     return MakeShared<FRemReflectedFunctionCallDataDetails>();
 }
 
+void FRemReflectedFunctionCallDataDetails::ReportMemory(TArray<Rem::Editor::FMemReportEntry>& OutEntries)
+{
+    OutEntries.Add({TEXT("Instances"), NumLiveInstances, NumLiveInstances * sizeof(ThisClass)});
+    OutEntries.Add({TEXT("Restrictions"), NumLiveRestrictions,
+        NumLiveRestrictions * (sizeof(FPropertyRestriction) + sizeof(FFunctionOwnerClassFilter))});
+}
+
 void FRemReflectedFunctionCallDataDetails::CustomizeHeader(const TSharedRef<IPropertyHandle> StructPropertyHandle,
     FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& StructCustomizationUtils)
 {
@@ -35,28 +97,37 @@ void FRemReflectedFunctionCallDataDetails::CustomizeHeader(const TSharedRef<IPro
 
     FunctionCallDataPropertyHandle = StructPropertyHandle;
 
-    const auto FunctionDataPropertyHandle = StructPropertyHandle->GetChildHandle(
-        FName{GET_MEMBER_NAME_ANSI_STRING_VIEW_CHECKED(FRemReflectedFunctionCallData, FunctionData)}, false);
+    static const FName FunctionNamePath = MakeMemberPath(
+        GET_MEMBER_NAME_ANSI_STRING_VIEW_CHECKED(FRemReflectedFunctionCallData, FunctionData),
+        GET_MEMBER_NAME_ANSI_STRING_VIEW_CHECKED(FRemReflectedFunctionData, FunctionName));
+    static const FName FunctionOwnerClassPath = MakeMemberPath(
+        GET_MEMBER_NAME_ANSI_STRING_VIEW_CHECKED(FRemReflectedFunctionCallData, FunctionData),
+        GET_MEMBER_NAME_ANSI_STRING_VIEW_CHECKED(FRemReflectedFunctionData, FunctionOwnerClass));
 
-    const auto FunctionNamePropertyHandle = FunctionDataPropertyHandle->GetChildHandle(
-        FName{GET_MEMBER_NAME_ANSI_STRING_VIEW_CHECKED(FRemReflectedFunctionData, FunctionName)}, false);
-    FunctionNamePropertyHandle->SetOnPropertyValueChangedWithData(
-        TDelegate<void(const FPropertyChangedEvent&)>::CreateSP(this, &ThisClass::OnFunctionNameChanged));
+    // FunctionData children are scanned once for both
+    const auto ChildHandles = Rem::Editor::ResolveChildHandles(StructPropertyHandle,
+        {FunctionNamePath, FunctionOwnerClassPath});
+
+    const auto* FunctionNamePropertyHandle       = ChildHandles.Find(FunctionNamePath);
+    const auto* FunctionOwnerClassPropertyHandle = ChildHandles.Find(FunctionOwnerClassPath);
+    RemCheckCondition(FunctionNamePropertyHandle && FunctionOwnerClassPropertyHandle, return;);
 
-    const auto FunctionOwnerClassPropertyHandle = FunctionDataPropertyHandle->GetChildHandle(
-        FName{GET_MEMBER_NAME_ANSI_STRING_VIEW_CHECKED(FRemReflectedFunctionData, FunctionOwnerClass)}, false);
+    (*FunctionNamePropertyHandle)->SetOnPropertyValueChangedWithData(
+        TDelegate<void(const FPropertyChangedEvent&)>::CreateSP(this, &ThisClass::OnFunctionNameChanged));
 
     // sync useful meta data from outer
     const auto AllowedClassesKey{FName{ANSITEXTVIEW("AllowedClasses")}};
     const auto DisallowedClassesKey{FName{ANSITEXTVIEW("DisallowedClasses")}};
-    FunctionOwnerClassPropertyHandle->SetInstanceMetaData(DisallowedClassesKey,
+    (*FunctionOwnerClassPropertyHandle)->SetInstanceMetaData(DisallowedClassesKey,
         FunctionCallDataPropertyHandle->GetMetaData(DisallowedClassesKey));
 
     static auto RestrictReason = NSLOCTEXT("RemReflectedFunctionCallData", "PassingClassFilter",
         "Passing meta data of class filter to FunctionOwnerClass");
 
+    LLM_SCOPE_BYTAG(RemCommonEditor);
+
     const auto Restriction = MakeShared<FPropertyRestriction>(RestrictReason);
-    const auto ClassFilter = MakeShared<FRemEditorUtilitiesClassFilter>();
+    const auto ClassFilter = MakeShared<FFunctionOwnerClassFilter>();
     ClassFilter->AllowedClasses.Append({PropertyCustomizationHelpers::GetClassesFromMetadataString(
             FunctionCallDataPropertyHandle->GetMetaData(AllowedClassesKey))
     });
@@ -64,8 +135,20 @@ void FRemReflectedFunctionCallDataDetails::CustomizeHeader(const TSharedRef<IPro
             FunctionCallDataPropertyHandle->GetMetaData(DisallowedClassesKey))
     });
 
+    if (CVarHideClassesWithoutFunctions.GetValueOnGameThread())
+    {
+        ClassFilter->ClassPredicate = [](const UClass& Class)
+        {
+            return FRemFunctionOwnerClassIndex::Get().HasSupportedFunctions(Class);
+        };
+        ClassFilter->UnloadedClassPredicate = [](const IUnloadedBlueprintData& UnloadedClassData)
+        {
+            return FRemFunctionOwnerClassIndex::HasSupportedFunctions(UnloadedClassData);
+        };
+    }
+
     Restriction->AddClassFilter(ClassFilter);
-    FunctionOwnerClassPropertyHandle->AddRestriction(Restriction);
+    (*FunctionOwnerClassPropertyHandle)->AddRestriction(Restriction);
 }
 
 void FRemReflectedFunctionCallDataDetails::CustomizeChildren(TSharedRef<IPropertyHandle> StructPropertyHandle,
@@ -91,7 +174,9 @@ void FRemReflectedFunctionCallDataDetails::OnFunctionNameChanged(
     RemCheckVariable(FunctionCallData, return;);
 
     const auto SavedFunctionName{FunctionCallData->FunctionData.FunctionName};
-    FunctionCallData->TryFillParameters();
+
+    // parameters are reflected once per function, undo, redo and multi-object edits only copy them
+    FRemFunctionSignatureCache::Get().FillParameters(*FunctionCallData);
 
     if (bool bFunctionNameGotRest = !SavedFunctionName.IsNone() && FunctionCallData->FunctionData.FunctionName.IsNone())
     {
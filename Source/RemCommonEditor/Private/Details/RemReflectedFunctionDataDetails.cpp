@@ -5,18 +5,58 @@
 
 #include "DetailWidgetRow.h"
 #include "IDetailChildrenBuilder.h"
+#include "RemCommonEditorStat.h"
 #include "RemEditorUtilitiesComboButton.inl"
+#include "RemEditorUtilitiesMemReport.h"
 #include "RemEditorUtilitiesStatics.h"
 #include "RemEditorUtilitiesStatics.inl"
+#include "RemEditorUtilitiesWidgetPool.h"
+#include "RemFunctionSignatureCache.h"
 #include "Macro/RemAssertionMacros.h"
 #include "Misc/AssertionMacros.h"
 #include "Struct/RemReflectedFunctionCallData.h"
+#include "Widgets/SNullWidget.h"
+
+namespace
+{
+/** customizations are made and destroyed on game thread only */
+TSet<const FRemReflectedFunctionDataDetails*> LiveInstances;
+}
+
+FRemReflectedFunctionDataDetails::FRemReflectedFunctionDataDetails()
+    : PooledWidgets(MakeUnique<Rem::Editor::FPooledWidgetOwner>())
+{
+    LiveInstances.Add(this);
+}
+
+FRemReflectedFunctionDataDetails::~FRemReflectedFunctionDataDetails()
+{
+    LiveInstances.Remove(this);
+}
 
 TSharedRef<IPropertyTypeCustomization> FRemReflectedFunctionDataDetails::MakeInstance()
 {
+    LLM_SCOPE_BYTAG(RemCommonEditor);
+
     return MakeShared<FRemReflectedFunctionDataDetails>();
 }
 
+void FRemReflectedFunctionDataDetails::ReportMemory(TArray<Rem::Editor::FMemReportEntry>& OutEntries)
+{
+    int64 NumListViewItems{};
+    SIZE_T ListViewItemsBytes{};
+
+    for (const auto* Instance : LiveInstances)
+    {
+        NumListViewItems += Instance->ListViewItems.Num();
+        ListViewItemsBytes += Instance->ListViewItems.GetAllocatedSize()
+            + Instance->ListViewItems.Num() * sizeof(FListViewItemType::ElementType);
+    }
+
+    OutEntries.Add({TEXT("Instances"), LiveInstances.Num(), LiveInstances.Num() * sizeof(ThisClass)});
+    OutEntries.Add({TEXT("ListViewItems"), NumListViewItems, ListViewItemsBytes});
+}
+
 void FRemReflectedFunctionDataDetails::CustomizeHeader(TSharedRef<IPropertyHandle> StructPropertyHandle,
     FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& StructCustomizationUtils)
 {
@@ -44,61 +84,145 @@ void FRemReflectedFunctionDataDetails::CustomizeChildren(const TSharedRef<IPrope
     auto& FunctionNameRow                         = StructBuilder.AddProperty(FunctionNameClassPropertyHandleRef);
 
     using namespace Rem::Editor;
-    MakeCustomWidgetForProperty(FunctionNameClassPropertyHandleRef, FunctionNameRow.CustomWidget(),
-        Rem::Enum::EContainerCombination::None,
-        [this](const TSharedRef<IPropertyHandle>& WidgetPropertyHandle)
+    MakePooledCustomWidgetForProperty(FunctionNameClassPropertyHandleRef, FunctionNameRow.CustomWidget(),
+        Rem::Enum::EContainerCombination::None, FName{TEXTVIEW("RemReflectedFunctionData.FunctionName")},
+        [](const TSharedRef<FPropertyWidgetBinding>& Binding)
         {
-            return MakeComboButton(WidgetPropertyHandle,
-                [this, WidgetPropertyHandle](TSharedRef<SComboButton>& ComboButton)
+            return MakeComboButton(Binding,
+                [Binding](const TSharedRef<SComboButton>& ComboButton)
                 {
-                    return FOnGetContent::CreateStatic(&GetPopupContent<FListViewItemType>,
-                        ComboButton,
-                        &ListViewItems,
-                        SListView<FListViewItemType>::FOnSelectionChanged::CreateLambda(
-                            [WidgetPropertyHandle, ComboButton](const FListViewItemType& InItem,
-                            const ESelectInfo::Type SelectionInfo)
-                            {
-                                using namespace Rem::Editor;
-
-                                if (SelectionInfo != ESelectInfo::Direct)
-                                {
-                                    // value should set successfully
-                                    RemCheckCondition(InItem, return);
-
-                                    RemCheckCondition(
-                                        WidgetPropertyHandle->SetValue(*InItem) == FPropertyAccess::Success);
-
-                                    ComboButton->SetIsOpen(false);
-                                }
-                            }),
-                        SListView<FListViewItemType>::FOnGenerateRow::CreateStatic(
-                            &OnGenerateListItem<FListViewItemType>,
-                            [](const FListViewItemType& InItem) -> FText
-                            {
-                                return FText::AsCultureInvariant(FText::FromName(InItem.IsValid()
-                                    ? *InItem
-                                    : NAME_None));
-                            }),
-                        [WidgetPropertyHandle]() -> FListViewItemType
-                        {
-                            FName FunctionName;
-                            RemCheckCondition(WidgetPropertyHandle->GetValue(FunctionName) == FPropertyAccess::Success);
-                            return FListViewItemType{MakeShared<FName>(FunctionName)};
-                        },
-                        [this, WidgetPropertyHandle](TSharedRef<SListView<FListViewItemType>> ListView)
+                    return FOnGetContent::CreateLambda(
+                        [Binding, WeakComboButton = TWeakPtr<SComboButton>{ComboButton},
+                            PopupContent = MakeShared<TPersistentPopupContent<FListViewItemType>>()]()
+                        -> TSharedRef<SWidget>
                         {
-                            return FOnTextChanged::CreateRaw(this, &ThisClass::OnFilterTextChanged,
-                                WidgetPropertyHandle, ListView);
-                        }
-                    );
+                            const auto PinnedComboButton = WeakComboButton.Pin();
+                            if (!PinnedComboButton)
+                            {
+                                return SNullWidget::NullWidget;
+                            }
+
+                            return GetFunctionNamePopupContent(Binding, PinnedComboButton.ToSharedRef(),
+                                *PopupContent);
+                        });
                 },
-                TAttribute<FText>::CreateLambda([WidgetPropertyHandle]() -> FText
+                TAttribute<FText>::CreateLambda([Binding]() -> FText
                 {
+                    const auto& WidgetPropertyHandle = Binding->GetPropertyHandle();
+                    RemCheckVariable(WidgetPropertyHandle, return {};);
+
                     FName FunctionName;
                     RemCheckCondition(WidgetPropertyHandle->GetValue(FunctionName) == FPropertyAccess::Success);
                     return FText::AsCultureInvariant(FText::FromName(FunctionName));
                 }));
-        });
+        },
+        *PooledWidgets, AsShared());
+}
+
+TSharedRef<SWidget> FRemReflectedFunctionDataDetails::GetFunctionNamePopupContent(
+    const TSharedRef<Rem::Editor::FPropertyWidgetBinding>& Binding, const TSharedRef<SComboButton>& ComboButton,
+    Rem::Editor::TPersistentPopupContent<FListViewItemType>& PopupContent)
+{
+    using namespace Rem::Editor;
+
+    // the combo button may be reused by another row, delegates read everything from the binding
+    const auto Self = Binding->GetCustomization<ThisClass>();
+    RemCheckVariable(Self, return SNullWidget::NullWidget;);
+
+    return PopupContent.GetOrBuild(ComboButton,
+        &Self->ListViewItems,
+        SListView<FListViewItemType>::FOnSelectionChanged::CreateLambda(
+            [Binding, WeakComboButton = TWeakPtr<SComboButton>{ComboButton}](
+            const FListViewItemType& InItem, const ESelectInfo::Type SelectionInfo)
+            {
+                using namespace Rem::Editor;
+
+                if (SelectionInfo != ESelectInfo::Direct)
+                {
+                    const auto& WidgetPropertyHandle = Binding->GetPropertyHandle();
+                    RemCheckVariable(WidgetPropertyHandle, return;);
+
+                    // value should set successfully
+                    RemCheckCondition(InItem, return);
+
+                    RemCheckCondition(WidgetPropertyHandle->SetValue(*InItem) == FPropertyAccess::Success);
+
+                    if (const auto PinnedComboButton = WeakComboButton.Pin())
+                    {
+                        PinnedComboButton->SetIsOpen(false);
+                    }
+                }
+            }),
+        SListView<FListViewItemType>::FOnGenerateRow::CreateStatic(
+            &OnGenerateListItemWithToolTip<FListViewItemType>,
+            [](const FListViewItemType& InItem) -> FText
+            {
+                return FText::AsCultureInvariant(FText::FromName(InItem.IsValid()
+                    ? *InItem
+                    : NAME_None));
+            },
+            [Binding](const FListViewItemType& InItem) -> FText
+            {
+                const auto PinnedSelf = Binding->GetCustomization<ThisClass>();
+                return PinnedSelf ? PinnedSelf->GetFunctionSignatureText(InItem) : FText::GetEmpty();
+            }),
+        [Binding]() -> FListViewItemType
+        {
+            const auto& WidgetPropertyHandle = Binding->GetPropertyHandle();
+            RemCheckVariable(WidgetPropertyHandle, return {};);
+
+            FName FunctionName;
+            RemCheckCondition(WidgetPropertyHandle->GetValue(FunctionName) == FPropertyAccess::Success);
+            return FListViewItemType{MakeShared<FName>(FunctionName)};
+        },
+        [Binding](const TSharedRef<SListView<FListViewItemType>>& ListView)
+        {
+            return FOnTextChanged::CreateLambda(
+                [Binding, WeakListView = TWeakPtr<SListView<FListViewItemType>>{ListView}](const FText& InFilterText)
+                {
+                    const auto PinnedSelf      = Binding->GetCustomization<ThisClass>();
+                    const auto PinnedListView  = WeakListView.Pin();
+                    const auto& PropertyHandle = Binding->GetPropertyHandle();
+                    if (PinnedSelf && PinnedListView && PropertyHandle)
+                    {
+                        PinnedSelf->OnFilterTextChanged(InFilterText, PropertyHandle.ToSharedRef(),
+                            PinnedListView.ToSharedRef());
+                    }
+                });
+        },
+        Self->GetFunctionListVersion());
+}
+
+uint32 FRemReflectedFunctionDataDetails::GetFunctionListVersion() const
+{
+    const auto* FunctionData{
+        Rem::Editor::GetStructPtr<FRemReflectedFunctionData>(FunctionDataPropertyHandle.ToSharedRef())
+    };
+    RemCheckVariable(FunctionData, return 0;);
+
+    const UClass* OwnerClass = FunctionData->FunctionOwnerClass;
+    return HashCombineFast(PointerHash(OwnerClass), FRemFunctionSignatureCache::Get().GetGeneration());
+}
+
+FText FRemReflectedFunctionDataDetails::GetFunctionSignatureText(const FListViewItemType& Item) const
+{
+    RemCheckVariable(Item, return {};);
+
+    const auto* FunctionData{
+        Rem::Editor::GetStructPtr<FRemReflectedFunctionData>(FunctionDataPropertyHandle.ToSharedRef())
+    };
+    RemCheckVariable(FunctionData, return {};);
+
+    const auto* Descriptor = FRemFunctionSignatureCache::Get().Find(FunctionData->FunctionOwnerClass, *Item);
+    if (!Descriptor)
+    {
+        return {};
+    }
+
+    return Descriptor->bSupported
+               ? Descriptor->SignatureText
+               : FText::Format(NSLOCTEXT("RemReflectedFunctionData", "UnsupportedFunctionSignature",
+                   "{0}\nParameter of this function is not supported"), Descriptor->SignatureText);
 }
 
 void FRemReflectedFunctionDataDetails::OnFilterTextChanged(const FText& InFilterText,
@@ -118,6 +242,8 @@ void FRemReflectedFunctionDataDetails::OnFilterTextChanged(const FText& InFilter
 
     const auto& CurrentFilterString = InFilterText.ToString();
 
+    LLM_SCOPE_BYTAG(RemCommonEditor);
+
     ListViewItems.Reset();
     for (const auto& FunctionName : FunctionNames)
     {
@@ -0,0 +1,283 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+
+#include "RemBulkEdit.h"
+
+#include "FileHelpers.h"
+#include "RemCommonEditorLog.h"
+#include "RemCommonEditorStatics.h"
+#include "RemEditorUtilitiesPropertyPathCache.h"
+#include "RemFunctionSignatureCache.h"
+#include "Macro/RemAssertionMacros.h"
+#include "Misc/ScopedSlowTask.h"
+#include "String/ParseTokens.h"
+#include "Struct/RemReflectedFunctionCallData.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UnrealType.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RemBulkEdit)
+
+#define LOCTEXT_NAMESPACE "RemBulkEdit"
+
+namespace
+{
+/**
+ * @brief A property value allocated and initialized for the property, destroyed with it
+ */
+struct FImportedPropertyValue : FNoncopyable
+{
+    const FProperty* Property{};
+    void* Data{};
+
+    explicit FImportedPropertyValue(const FProperty& InProperty)
+        : Property(&InProperty)
+        , Data(InProperty.AllocateAndInitializeValue())
+    {
+    }
+
+    ~FImportedPropertyValue()
+    {
+        Property->DestroyAndFreeValue(Data);
+    }
+
+    bool Import(const FString& Text) const
+    {
+        return Property->ImportText_Direct(*Text, Data, nullptr, PPF_None) != nullptr;
+    }
+};
+
+/**
+ * @brief The property path resolved against a class, with match and replacement values imported for the leaf property
+ */
+struct FResolvedPropertyPath
+{
+    /** struct properties from the object to the leaf */
+    TArray<const FStructProperty*, TInlineAllocator<4>> StructChain;
+    const FProperty* Leaf{};
+
+    TUniquePtr<FImportedPropertyValue> MatchValue;
+    TUniquePtr<FImportedPropertyValue> ReplacementValue;
+};
+
+TUniquePtr<FResolvedPropertyPath> ResolvePropertyPath(const UStruct& OwnerStruct, const FString& PropertyPath)
+{
+    auto ResolvedPath = MakeUnique<FResolvedPropertyPath>();
+    const UStruct* CurrentStruct = &OwnerStruct;
+
+    bool bValid = true;
+    UE::String::ParseTokens(PropertyPath, TEXT('.'), [&](const FStringView Token)
+    {
+        if (!bValid)
+        {
+            return;
+        }
+
+        if (ResolvedPath->Leaf)
+        {
+            // leaf is not the last token, it must be a struct to step into
+            const auto* StructProperty = CastField<FStructProperty>(ResolvedPath->Leaf);
+            if (!StructProperty)
+            {
+                bValid = false;
+                return;
+            }
+
+            ResolvedPath->StructChain.Add(StructProperty);
+            CurrentStruct = StructProperty->Struct;
+        }
+
+        // a member name is the path of a struct member
+        ResolvedPath->Leaf = Rem::Editor::FPropertyPathCache::Get().FindProperty(*CurrentStruct, FName{Token});
+        bValid             = ResolvedPath->Leaf != nullptr;
+    }, UE::String::EParseTokensOptions::SkipEmpty | UE::String::EParseTokensOptions::Trim);
+
+    if (!bValid || !ResolvedPath->Leaf)
+    {
+        return {};
+    }
+
+    return ResolvedPath;
+}
+
+bool EditObject(UObject& Object, const FResolvedPropertyPath& ResolvedPath, const bool bDryRun)
+{
+    void* ValuePtr{&Object};
+    FRemReflectedFunctionCallData* FunctionCallData{};
+
+    for (const auto* StructProperty : ResolvedPath.StructChain)
+    {
+        ValuePtr = StructProperty->ContainerPtrToValuePtr<void>(ValuePtr);
+
+        if (StructProperty->Struct == FRemReflectedFunctionCallData::StaticStruct())
+        {
+            FunctionCallData = static_cast<FRemReflectedFunctionCallData*>(ValuePtr);
+        }
+    }
+
+    const auto* Leaf = ResolvedPath.Leaf;
+    ValuePtr         = Leaf->ContainerPtrToValuePtr<void>(ValuePtr);
+
+    if (Leaf->Identical(ValuePtr, ResolvedPath.ReplacementValue->Data)
+        || (ResolvedPath.MatchValue && !Leaf->Identical(ValuePtr, ResolvedPath.MatchValue->Data)))
+    {
+        return false;
+    }
+
+    if (bDryRun)
+    {
+        UE_LOG(LogRemCommonEditor, Display, TEXT("Would edit %s"), *Object.GetPathName());
+        return true;
+    }
+
+    // the same chain the details panel notifies for a nested edit, the outermost struct is the member property
+    FEditPropertyChain PropertyChain;
+    for (const auto* StructProperty : ResolvedPath.StructChain)
+    {
+        PropertyChain.AddTail(const_cast<FStructProperty*>(StructProperty));
+    }
+
+    PropertyChain.AddTail(const_cast<FProperty*>(Leaf));
+    PropertyChain.SetActivePropertyNode(const_cast<FProperty*>(Leaf));
+    PropertyChain.SetActiveMemberPropertyNode(PropertyChain.GetHead()->GetValue());
+
+    Object.Modify();
+    Object.PreEditChange(PropertyChain);
+
+    Leaf->CopyCompleteValue(ValuePtr, ResolvedPath.ReplacementValue->Data);
+
+    if (FunctionCallData)
+    {
+        FRemFunctionSignatureCache::Get().FillParameters(*FunctionCallData);
+    }
+
+    FPropertyChangedEvent ChangedEvent{const_cast<FProperty*>(Leaf), EPropertyChangeType::ValueSet};
+    ChangedEvent.SetActiveMemberProperty(PropertyChain.GetActiveMemberNode()->GetValue());
+
+    FPropertyChangedChainEvent ChainEvent{PropertyChain, ChangedEvent};
+    Object.PostEditChangeChainProperty(ChainEvent);
+
+    return true;
+}
+}
+
+namespace Rem::CommonEditor
+{
+
+FRemBulkEditResult BulkEditProperties(const FRemBulkEditRequest& Request)
+{
+    FRemBulkEditResult Result;
+    const double StartTime = FPlatformTime::Seconds();
+
+    RemCheckCondition(!Request.PropertyPath.IsEmpty(), return Result;);
+
+    const TArray<FName> PackageNames = GatherPackageNames(Request.PackagePaths);
+
+    Result.NumPackagesFound = PackageNames.Num();
+    Result.bSucceeded       = true;
+
+    // resolved per class, nullptr if the class doesn't have the property
+    TMap<TObjectKey<UClass>, TUniquePtr<FResolvedPropertyPath>> ResolvedPaths;
+
+    auto FindResolvedPath = [&](const UClass& Class) -> const FResolvedPropertyPath*
+    {
+        if (const auto* Found = ResolvedPaths.Find(&Class))
+        {
+            return Found->Get();
+        }
+
+        auto ResolvedPath = ResolvePropertyPath(Class, Request.PropertyPath);
+        if (ResolvedPath)
+        {
+            ResolvedPath->ReplacementValue = MakeUnique<FImportedPropertyValue>(*ResolvedPath->Leaf);
+            if (!ResolvedPath->ReplacementValue->Import(Request.ReplacementValue))
+            {
+                UE_LOG(LogRemCommonEditor, Error, TEXT("Can't import \"%s\" as the value of %s"),
+                    *Request.ReplacementValue, *ResolvedPath->Leaf->GetPathName());
+                Result.bSucceeded = false;
+                ResolvedPath.Reset();
+            }
+        }
+
+        if (ResolvedPath && !Request.MatchValue.IsEmpty())
+        {
+            ResolvedPath->MatchValue = MakeUnique<FImportedPropertyValue>(*ResolvedPath->Leaf);
+            if (!ResolvedPath->MatchValue->Import(Request.MatchValue))
+            {
+                UE_LOG(LogRemCommonEditor, Error, TEXT("Can't import \"%s\" as the value of %s"),
+                    *Request.MatchValue, *ResolvedPath->Leaf->GetPathName());
+                Result.bSucceeded = false;
+                ResolvedPath.Reset();
+            }
+        }
+
+        return ResolvedPaths.Add(&Class, MoveTemp(ResolvedPath)).Get();
+    };
+
+    FScopedSlowTask SlowTask(PackageNames.Num(), LOCTEXT("BulkEditProperties", "Bulk editing properties"));
+    SlowTask.MakeDialog(true);
+
+    TArray<UObject*> Objects;
+    TArray<UPackage*> DirtyPackages;
+
+    ForEachPackageBatch(PackageNames, Request.BatchSize, [&](const TConstArrayView<UPackage*> Packages)
+    {
+        if (SlowTask.ShouldCancel())
+        {
+            return false;
+        }
+
+        SlowTask.EnterProgressFrame(Packages.Num());
+        Result.NumPackagesLoaded += Packages.Num();
+
+        DirtyPackages.Reset();
+        for (auto* Package : Packages)
+        {
+            Objects.Reset();
+            GetObjectsWithPackage(Package, Objects, true, RF_Transient);
+
+            bool bPackageEdited{};
+            for (auto* Object : Objects)
+            {
+                const auto* ResolvedPath = FindResolvedPath(*Object->GetClass());
+                if (ResolvedPath && EditObject(*Object, *ResolvedPath, Request.bDryRun))
+                {
+                    ++Result.NumObjectsEdited;
+                    bPackageEdited = true;
+                }
+            }
+
+            if (bPackageEdited && !Request.bDryRun && Package->IsDirty())
+            {
+                DirtyPackages.Add(Package);
+            }
+        }
+
+        if (!DirtyPackages.IsEmpty() && UEditorLoadingAndSavingUtils::SavePackages(DirtyPackages, true))
+        {
+            Result.NumPackagesSaved += DirtyPackages.Num();
+        }
+
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+        UE_LOG(LogRemCommonEditor, Display,
+            TEXT("Bulk edit: %d/%d packages loaded, %d objects edited, %d packages saved, %.1f packages/s"),
+            Result.NumPackagesLoaded, Result.NumPackagesFound, Result.NumObjectsEdited, Result.NumPackagesSaved,
+            Elapsed > 0.0 ? Result.NumPackagesLoaded / Elapsed : 0.0);
+
+        if (IsRunningCommandlet())
+        {
+            // don't keep every batch in memory, properties of collected classes go with it
+            ResolvedPaths.Reset();
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+
+        return true;
+    });
+
+    Result.Seconds = FPlatformTime::Seconds() - StartTime;
+    return Result;
+}
+
+}
+
+#undef LOCTEXT_NAMESPACE
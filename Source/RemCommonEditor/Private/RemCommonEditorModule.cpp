@@ -3,15 +3,24 @@
 #include "RemCommonEditorModule.h"
 
 #include "Modules/ModuleManager.h"
+#include "Engine/Engine.h"
 #include "GameplayTagsManager.h"
 #include "GameplayTag/RemGameplayTagWithCategory.h"
 #include "PropertyHandle.h"
 #include "RemCommonEditorLog.h"
+#include "RemEditorTickDispatcher.h"
+#include "RemEditorTickRelevance.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesPropertyVisitor.h"
+#include "RemEditorUtilitiesStartupTimer.h"
+#include "RemFunctionOwnerClassIndex.h"
+#include "RemFunctionSignatureCache.h"
 #include "Details/RemReflectedFunctionCallDataDetails.h"
 #include "Details/RemReflectedFunctionDataDetails.h"
 #include "GameplayTag/RemGameplayTagArray.h"
 #include "Macro/RemAssertionMacros.h"
 #include "Macro/RemLogMacros.h"
+#include "Misc/CoreDelegates.h"
 #include "Struct/RemReflectedFunctionCallData.h"
 #include "Struct/RemReflectedFunctionData.h"
 
@@ -35,6 +44,18 @@ public:
 
     using ThisClass = FRemCommonEditorModule;
     FDelegateHandle DelegateHandle;
+    FDelegateHandle OnPostEngineInitHandle;
+    FDelegateHandle FunctionDataMemReportHandle;
+    FDelegateHandle FunctionCallDataMemReportHandle;
+    bool bRegistered{};
+
+    /**
+     * @brief Register customizations and hooks, deferred to engine init so loading this module doesn't pull in
+     * property editor and gameplay tags manager
+     */
+    void Register();
+    void Unregister();
+
     static void OnGetCategoriesMetaFromPropertyHandle(const TSharedPtr<IPropertyHandle> PropertyHandle,
         FString& OutCategoryString);
 };
@@ -46,6 +67,44 @@ void FRemCommonEditorModule::StartupModule()
     // This code will execute after your module is loaded into memory (but after global variables are initialized, of course.)
     IRemCommonEditorModule::StartupModule();
 
+    // loaded after engine init, eg: plugin enabled at runtime
+    if (GEngine && GEngine->IsInitialized())
+    {
+        Register();
+    }
+    else
+    {
+        OnPostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &ThisClass::Register);
+    }
+}
+
+void FRemCommonEditorModule::ShutdownModule()
+{
+    FCoreDelegates::OnPostEngineInit.Remove(OnPostEngineInitHandle);
+
+    Unregister();
+
+    FRemFunctionOwnerClassIndex::Shutdown();
+    FRemFunctionSignatureCache::Shutdown();
+    FRemEditorTickDispatcher::Shutdown();
+    FRemEditorTickRelevance::Shutdown();
+
+    // This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
+    // we call this function before unloading the module.
+    IRemCommonEditorModule::ShutdownModule();
+}
+
+void FRemCommonEditorModule::Register()
+{
+    if (bRegistered)
+    {
+        return;
+    }
+
+    bRegistered = true;
+
+    const Rem::Editor::FScopedStartupTimer StartupTimer{TEXT("RemCommonEditor.Register")};
+
     DelegateHandle = UGameplayTagsManager::Get().OnGetCategoriesMetaFromPropertyHandle.AddStatic(
         &ThisClass::OnGetCategoriesMetaFromPropertyHandle);
 
@@ -54,24 +113,39 @@ void FRemCommonEditorModule::StartupModule()
         FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FRemReflectedFunctionCallDataDetails::MakeInstance));
     PropertyModule.RegisterCustomPropertyTypeLayout(FRemReflectedFunctionData::StaticStruct()->GetFName(),
         FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FRemReflectedFunctionDataDetails::MakeInstance));
+
+    auto& MemReport = Rem::Editor::FMemReport::Get();
+    FunctionDataMemReportHandle = MemReport.Register(TEXT("RemReflectedFunctionDataDetails"),
+        Rem::Editor::FMemReportProvider::CreateStatic(&FRemReflectedFunctionDataDetails::ReportMemory));
+    FunctionCallDataMemReportHandle = MemReport.Register(TEXT("RemReflectedFunctionCallDataDetails"),
+        Rem::Editor::FMemReportProvider::CreateStatic(&FRemReflectedFunctionCallDataDetails::ReportMemory));
+
+    // start indexing function owner classes when the editor is idle
+    FRemFunctionOwnerClassIndex::Get();
 }
 
-void FRemCommonEditorModule::ShutdownModule()
+void FRemCommonEditorModule::Unregister()
 {
-    auto* PropertyModule = FModuleManager::GetModulePtr<FPropertyEditorModule>("PropertyEditor");
-    RemCheckVariable(PropertyModule, return;);
+    if (!bRegistered)
+    {
+        return;
+    }
 
-    PropertyModule->UnregisterCustomPropertyTypeLayout(FRemReflectedFunctionData::StaticStruct()->GetFName());
-    PropertyModule->UnregisterCustomPropertyTypeLayout(FRemReflectedFunctionCallData::StaticStruct()->GetFName());
+    bRegistered = false;
+
+    Rem::Editor::FMemReport::Unregister(FunctionDataMemReportHandle);
+    Rem::Editor::FMemReport::Unregister(FunctionCallDataMemReportHandle);
 
     if (auto* GameplayTagsManager = UGameplayTagsManager::GetIfAllocated())
     {
         GameplayTagsManager->OnGetCategoriesMetaFromPropertyHandle.Remove(DelegateHandle);
     }
 
-    // This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
-    // we call this function before unloading the module.
-    IRemCommonEditorModule::ShutdownModule();
+    auto* PropertyModule = FModuleManager::GetModulePtr<FPropertyEditorModule>("PropertyEditor");
+    RemCheckVariable(PropertyModule, return;);
+
+    PropertyModule->UnregisterCustomPropertyTypeLayout(FRemReflectedFunctionData::StaticStruct()->GetFName());
+    PropertyModule->UnregisterCustomPropertyTypeLayout(FRemReflectedFunctionCallData::StaticStruct()->GetFName());
 }
 
 // ReSharper disable once CppPassValueParameterByConstReference
@@ -102,6 +176,56 @@ void FRemCommonEditorModule::OnGetCategoriesMetaFromPropertyHandle(const TShared
         Field && Field->Struct == FGameplayTag::StaticStruct()
         && Field->GetFName() == GET_MEMBER_NAME_ANSI_STRING_VIEW_CHECKED(FRemGameplayTagArray, Tags))
     {
+        /**
+         * find the FRemGameplayTagArray owning the tag array, directly or inside an instanced struct.
+         * unset result means keep walking up, set result means stop (null on failure)
+         */
+        struct FTagArrayOwnerVisitor
+            : Rem::Editor::TPropertyVisitor<FTagArrayOwnerVisitor, FObjectPropertyBase,
+                TOptional<const FRemGameplayTagArray*>>
+        {
+            const TSharedRef<IPropertyHandle> Handle;
+
+            explicit FTagArrayOwnerVisitor(const TSharedRef<IPropertyHandle>& InHandle)
+                : Handle(InHandle)
+            {
+            }
+
+            TOptional<const FRemGameplayTagArray*> VisitStruct(const FStructProperty& StructProperty) const
+            {
+                if (StructProperty.Struct != FRemGameplayTagArray::StaticStruct())
+                {
+                    return {};
+                }
+
+                void* OutAddress = nullptr;
+                RemCheckCondition(Handle->GetValueData(OutAddress) == FPropertyAccess::Success, return nullptr;);
+
+                return static_cast<const FRemGameplayTagArray*>(OutAddress);
+            }
+
+            TOptional<const FRemGameplayTagArray*> VisitInstancedStruct(const FStructProperty& StructProperty) const
+            {
+                void* OutAddress = nullptr;
+                RemCheckCondition(Handle->GetValueData(OutAddress) == FPropertyAccess::Success, return nullptr;);
+
+                if (auto* InstancedStruct = static_cast<const FInstancedStruct*>(OutAddress))
+                {
+                    if (auto* TagArray = InstancedStruct->GetPtr<const FRemGameplayTagArray>())
+                    {
+                        return TagArray;
+                    }
+                }
+
+                return {};
+            }
+
+            TOptional<const FRemGameplayTagArray*> VisitOther(const FProperty& Property) const
+            {
+                return {};
+            }
+        };
+
         auto Parent{PropertyHandle};
         const FRemGameplayTagArray* GameplayTagWithCategory{};
 
@@ -113,32 +237,18 @@ void FRemCommonEditorModule::OnGetCategoriesMetaFromPropertyHandle(const TShared
                 break;
             }
 
-            if (const auto* StructProperty = CastField<FStructProperty>(Parent->GetProperty());
-                StructProperty)
+            const auto* ParentProperty = Parent->GetProperty();
+            if (!ParentProperty)
             {
-                if (StructProperty->Struct == FRemGameplayTagArray::StaticStruct())
-                {
-                    void* OutAddress = nullptr;
-                    RemCheckCondition(Parent->GetValueData(OutAddress) == FPropertyAccess::Success, return;);
-
-                    GameplayTagWithCategory = static_cast<const FRemGameplayTagArray*>(OutAddress);
-                    break;
-                }
-
-                if (StructProperty->Struct == FInstancedStruct::StaticStruct())
-                {
-                    void* OutAddress = nullptr;
-                    RemCheckCondition(Parent->GetValueData(OutAddress) == FPropertyAccess::Success, return;);
+                continue;
+            }
 
-                    if (auto* InstancedStruct = static_cast<const FInstancedStruct*>(OutAddress))
-                    {
-                        if (GameplayTagWithCategory = InstancedStruct->GetPtr<const FRemGameplayTagArray>();
-                            GameplayTagWithCategory)
-                        {
-                            break;
-                        }
-                    }
-                }
+            FTagArrayOwnerVisitor Visitor{Parent.ToSharedRef()};
+            if (const auto Result = Rem::Editor::VisitProperty(*ParentProperty, Visitor);
+                Result.IsSet())
+            {
+                GameplayTagWithCategory = Result.GetValue();
+                break;
             }
         }
 
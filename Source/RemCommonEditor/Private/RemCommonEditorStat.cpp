@@ -2,3 +2,5 @@
 
 
 #include "RemCommonEditorStat.h"
+
+LLM_DEFINE_TAG(RemCommonEditor);
@@ -3,4 +3,83 @@
 
 #include "RemCommonEditorStatics.h"
 
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Macro/RemAssertionMacros.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RemCommonEditorStatics)
+
+FRemBulkEditResult URemCommonEditorStatics::BulkEditProperties(const FRemBulkEditRequest& Request)
+{
+    return Rem::CommonEditor::BulkEditProperties(Request);
+}
+
+namespace Rem::CommonEditor
+{
+
+TArray<FName> GatherPackageNames(const TConstArrayView<FName> PackagePaths)
+{
+    auto* AssetRegistry = IAssetRegistry::Get();
+    RemCheckVariable(AssetRegistry, return {};);
+
+    if (AssetRegistry->IsLoadingAssets())
+    {
+        AssetRegistry->WaitForCompletion();
+    }
+
+    FARFilter Filter;
+    Filter.PackagePaths    = TArray<FName>{PackagePaths};
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> Assets;
+    AssetRegistry->GetAssets(Filter, Assets);
+
+    TSet<FName> UniquePackageNames;
+    UniquePackageNames.Reserve(Assets.Num());
+    for (const auto& Asset : Assets)
+    {
+        UniquePackageNames.Add(Asset.PackageName);
+    }
+
+    return UniquePackageNames.Array();
+}
+
+void ForEachPackageBatch(const TConstArrayView<FName> PackageNames, const int32 BatchSize,
+    const TFunctionRef<bool(TConstArrayView<UPackage*> Packages)> BatchFunction)
+{
+    const int32 ClampedBatchSize = FMath::Max(BatchSize, 1);
+
+    TArray<int32> RequestIds;
+    TArray<UPackage*> LoadedPackages;
+    RequestIds.Reserve(ClampedBatchSize);
+    LoadedPackages.Reserve(ClampedBatchSize);
+
+    for (int32 BatchStart = 0; BatchStart < PackageNames.Num(); BatchStart += ClampedBatchSize)
+    {
+        RequestIds.Reset();
+        LoadedPackages.Reset();
+
+        for (const auto& PackageName : PackageNames.Slice(BatchStart,
+                 FMath::Min(ClampedBatchSize, PackageNames.Num() - BatchStart)))
+        {
+            RequestIds.Add(LoadPackageAsync(PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+                [&LoadedPackages](const FName&, UPackage* Package, const EAsyncLoadingResult::Type Result)
+                {
+                    if (Result == EAsyncLoadingResult::Succeeded && Package)
+                    {
+                        LoadedPackages.Add(Package);
+                    }
+                })));
+        }
+
+        FlushAsyncLoading(RequestIds);
+
+        if (!BatchFunction(LoadedPackages))
+        {
+            return;
+        }
+    }
+}
+
+}
@@ -3,13 +3,19 @@
 
 #include "RemEditorOnlyTickableActor.h"
 
+#include "RemCommonEditorStat.h"
 #include "RemEditorTickableHelper.h"
+#include "RemEditorTickDispatcher.h"
+#include "RemEditorTickRelevance.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
 #include "Macro/RemAssertionMacros.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RemEditorOnlyTickableActor)
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Editor Ticks Skipped As Irrelevant"), STAT_RemEditorTicksSkipped,
+    STATGROUP_RemCommonEditor);
+
 namespace
 {
 TAutoConsoleVariable CVarEnableEditorTickableActor(TEXT("Rem.Editor.Tickable.Actor.Enable"), true,
@@ -40,35 +46,140 @@ void ARemEditorOnlyTickableActor::PostActorCreated()
 
     // EditorTickableHelper = MakeShared<FRemEditorTickableHelper>(this);
 
+    StartEditorTick();
+}
+
+void ARemEditorOnlyTickableActor::Destroyed()
+{
+    StopEditorTick();
+
+    Super::Destroyed();
+}
+
+void ARemEditorOnlyTickableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // only reached by actors which began play, editor world actors never do. FRemEditorTickDispatcher unregisters
+    // them when their level is removed from the world, and registers them again once it's added back
+    StopEditorTick();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ARemEditorOnlyTickableActor::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // only actors already ticking, templates have no world
+    const auto* World = GetWorld();
+    if (!World || !World->IsEditorWorld() || !CVarEnableEditorTickableActor.GetValueOnGameThread())
+    {
+        return;
+    }
+
+    const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, EditorTickMode))
+    {
+        StopEditorTick();
+        StartEditorTick();
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, EditorTickDependentProperties)
+             || PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, bEditorTickOnTransformChanged)
+             || PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, EditorTickDependentActors)
+             || PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, EditorTickDependentAssets))
+    {
+        UpdateEditorTickDependencies();
+    }
+}
+
+void ARemEditorOnlyTickableActor::EditorTick(const float DeltaSeconds)
+{
+    auto* World = GetWorld();
+    RemCheckVariable(World, return;);
+
+    RemCheckCondition(REM_NO_ASSERTION, CVarEnableEditorTickableActor.GetValueOnGameThread(), return;);
+
+    BP_EditorTick(FMath::Max(World->GetDeltaSeconds(), DeltaSeconds));
+}
+
+void ARemEditorOnlyTickableActor::GatherEditorTickDependencies(FRemEditorTickDependencies& OutDependencies) const
+{
+    OutDependencies.Properties = EditorTickDependentProperties;
+    OutDependencies.bTransform = bEditorTickOnTransformChanged;
+
+    for (const auto& Actor : EditorTickDependentActors)
+    {
+        if (Actor)
+        {
+            OutDependencies.Objects.Add(Actor);
+        }
+    }
+
+    for (const auto& Asset : EditorTickDependentAssets)
+    {
+        if (Asset)
+        {
+            OutDependencies.Objects.Add(Asset);
+        }
+    }
+}
+
+void ARemEditorOnlyTickableActor::MarkEditorTickDirty()
+{
+    if (FRemEditorTickDispatcher::IsRegistered(*this))
+    {
+        FRemEditorTickDispatcher::Get().MarkDirty(*this);
+    }
+}
+
+void ARemEditorOnlyTickableActor::UpdateEditorTickDependencies()
+{
+    if (FRemEditorTickDispatcher::IsRegistered(*this))
+    {
+        FRemEditorTickDispatcher::Get().Register(*this);
+    }
+}
+
+void ARemEditorOnlyTickableActor::StartEditorTick()
+{
+    auto* World = GetWorld();
+    RemCheckVariable(World, return;);
+
     if (!PrimaryActorTick.bStartWithTickEnabled)
     {
         return;
     }
 
+    if (EditorTickMode == ERemEditorTickMode::OnChange)
+    {
+        FRemEditorTickDispatcher::Get().Register(*this);
+        return;
+    }
+
     World->GetTimerManager().SetTimer(EditorTickHandle,
-        FTimerDelegate::CreateUObject(this, &ThisClass::EditorTick, PrimaryActorTick.TickInterval),
+        FTimerDelegate::CreateUObject(this, &ThisClass::ConditionalEditorTick, PrimaryActorTick.TickInterval),
         FMath::Max(PrimaryActorTick.TickInterval, UE_KINDA_SMALL_NUMBER),
         {.bLoop = true, .bMaxOncePerFrame = true});
 
     RemCheckVariable(EditorTickHandle);
 }
 
-void ARemEditorOnlyTickableActor::Destroyed()
+void ARemEditorOnlyTickableActor::StopEditorTick()
 {
+    FRemEditorTickDispatcher::Unregister(*this);
+
     auto* World = GetWorld();
     RemCheckVariable(World, return;);
 
     World->GetTimerManager().ClearTimer(EditorTickHandle);
-
-    Super::Destroyed();
 }
 
-void ARemEditorOnlyTickableActor::EditorTick(const float DeltaSeconds)
+void ARemEditorOnlyTickableActor::ConditionalEditorTick(const float DeltaSeconds)
 {
-    auto* World = GetWorld();
-    RemCheckVariable(World, return;);
-
-    RemCheckCondition(REM_NO_ASSERTION, CVarEnableEditorTickableActor.GetValueOnGameThread(), return;);
+    if (!FRemEditorTickRelevance::Get().IsRelevant(*this))
+    {
+        INC_DWORD_STAT(STAT_RemEditorTicksSkipped);
+        return;
+    }
 
-    BP_EditorTick(FMath::Max(World->GetDeltaSeconds(), DeltaSeconds));
+    EditorTick(DeltaSeconds);
 }
@@ -0,0 +1,412 @@
+// Copyright RemRemRemRe. 2025. All Rights Reserved.
+
+
+#include "RemEditorTickDispatcher.h"
+
+#include "Editor.h"
+#include "RemCommonEditorStat.h"
+#include "RemEditorOnlyTickableActor.h"
+#include "RemEditorTickRelevance.h"
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "Selection.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Editor Ticks On Change"), STAT_RemEditorTicksOnChange,
+    STATGROUP_RemCommonEditor);
+DECLARE_CYCLE_STAT(TEXT("Dispatch Editor Ticks On Change"), STAT_RemDispatchEditorTicks, STATGROUP_RemCommonEditor);
+
+FRemEditorTickDispatcher::FRemEditorTickDispatcher()
+{
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &ThisClass::Tick));
+
+    OnObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this,
+        &ThisClass::OnObjectPropertyChanged);
+
+    if (GEngine)
+    {
+        OnActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &ThisClass::OnActorMoved);
+    }
+
+    if (auto* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+    {
+        OnAssetReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &ThisClass::OnAssetReimport);
+    }
+
+    // what could make parked actors relevant
+    OnSelectionChangedHandle  = USelection::SelectionChangedEvent.AddRaw(this, &ThisClass::OnSelectionChanged);
+    OnSelectObjectHandle      = USelection::SelectObjectEvent.AddRaw(this, &ThisClass::OnSelectionChanged);
+    OnEditorCameraMovedHandle = FEditorDelegates::OnEditorCameraMoved.AddRaw(this, &ThisClass::OnEditorCameraMoved);
+    OnLevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &ThisClass::OnLevelAddedToWorld);
+    OnLevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this,
+        &ThisClass::OnLevelRemovedFromWorld);
+
+    // dependencies could be reinstanced, only the index is rebuilt, nothing they depend on changed by that.
+    // reinstanced actors register themselves on spawn
+    RegisterInvalidation(TEXT("EditorTickDispatcher"),
+        Rem::Editor::EInvalidationReason::BlueprintCompiled | Rem::Editor::EInvalidationReason::ObjectsReinstanced,
+        Rem::Editor::FOnInvalidated::CreateLambda([this](Rem::Editor::EInvalidationReason)
+        {
+            Dependents.Reset();
+
+            for (auto It = Registrations.CreateIterator(); It; ++It)
+            {
+                if (auto* Actor = It->Value.Actor.Get())
+                {
+                    GatherDependencies(It->Key, It->Value, *Actor);
+                }
+                else
+                {
+                    It.RemoveCurrent();
+                }
+            }
+        }));
+}
+
+FRemEditorTickDispatcher::~FRemEditorTickDispatcher()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnObjectPropertyChangedHandle);
+
+    if (GEngine)
+    {
+        GEngine->OnActorMoved().Remove(OnActorMovedHandle);
+    }
+
+    if (auto* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+    {
+        ImportSubsystem->OnAssetReimport.Remove(OnAssetReimportHandle);
+    }
+
+    USelection::SelectionChangedEvent.Remove(OnSelectionChangedHandle);
+    USelection::SelectObjectEvent.Remove(OnSelectObjectHandle);
+    FEditorDelegates::OnEditorCameraMoved.Remove(OnEditorCameraMovedHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(OnLevelAddedToWorldHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(OnLevelRemovedFromWorldHandle);
+}
+
+void FRemEditorTickDispatcher::Register(ARemEditorOnlyTickableActor& Actor)
+{
+    const TObjectKey<ARemEditorOnlyTickableActor> ActorKey{&Actor};
+
+    auto* Registration = Registrations.Find(ActorKey);
+    if (!Registration)
+    {
+        // the first EditorTick gets the time since registration
+        Registration               = &Registrations.Add(ActorKey);
+        Registration->LastTickTime = FApp::GetCurrentTime();
+    }
+
+    RemoveDependents(ActorKey, Registration->Dependencies);
+
+    Registration->Actor = &Actor;
+    GatherDependencies(ActorKey, *Registration, Actor);
+
+    // dependencies could have changed while not being watched
+    MarkDirty(Actor);
+}
+
+void FRemEditorTickDispatcher::Unregister(const ARemEditorOnlyTickableActor& Actor)
+{
+    if (auto* Dispatcher = TryGet())
+    {
+        Dispatcher->RemoveRegistration(&Actor);
+    }
+}
+
+bool FRemEditorTickDispatcher::IsRegistered(const ARemEditorOnlyTickableActor& Actor)
+{
+    const auto* Dispatcher = TryGet();
+    return Dispatcher && Dispatcher->Registrations.Contains(&Actor);
+}
+
+void FRemEditorTickDispatcher::MarkDirty(const ARemEditorOnlyTickableActor& Actor)
+{
+    const TObjectKey<ARemEditorOnlyTickableActor> ActorKey{&Actor};
+    if (ActorKey == TickingActor)
+    {
+        return;
+    }
+
+    auto* Registration = Registrations.Find(ActorKey);
+    if (!Registration || Registration->bDirty)
+    {
+        return;
+    }
+
+    Registration->bDirty = true;
+    DirtyActors.Add(ActorKey);
+}
+
+bool FRemEditorTickDispatcher::Tick(float)
+{
+    if (DirtyActors.IsEmpty())
+    {
+        return true;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_RemDispatchEditorTicks);
+
+    auto& Relevance         = FRemEditorTickRelevance::Get();
+    const auto ActorsToTick = MoveTemp(DirtyActors);
+    DirtyActors.Reset();
+
+    for (const auto& ActorKey : ActorsToTick)
+    {
+        auto* Registration = Registrations.Find(ActorKey);
+        if (!Registration || !Registration->bDirty)
+        {
+            continue;
+        }
+
+        auto* Actor = Registration->Actor.Get();
+        if (!Actor)
+        {
+            continue;
+        }
+
+        // tick it once it becomes relevant, nothing is checked until then
+        if (!Relevance.IsRelevant(*Actor))
+        {
+            Registration->bParked = true;
+            ParkedActors.Add(ActorKey);
+            continue;
+        }
+
+        // registrations could be added while ticking, don't touch it afterward
+        const double CurrentTime   = FApp::GetCurrentTime();
+        const double DeltaSeconds  = CurrentTime - Registration->LastTickTime;
+        Registration->LastTickTime = CurrentTime;
+        Registration->bDirty       = false;
+
+        INC_DWORD_STAT(STAT_RemEditorTicksOnChange);
+
+        TickingActor = ActorKey;
+        Actor->EditorTick(static_cast<float>(DeltaSeconds));
+        TickingActor = {};
+    }
+
+    return true;
+}
+
+void FRemEditorTickDispatcher::GatherDependencies(const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey,
+    FRegistration& Registration, const ARemEditorOnlyTickableActor& Actor)
+{
+    Registration.Dependencies = {};
+    Actor.GatherEditorTickDependencies(Registration.Dependencies);
+
+    for (const auto* Object : Registration.Dependencies.Objects)
+    {
+        if (Object)
+        {
+            Dependents.FindOrAdd(Object).AddUnique(ActorKey);
+        }
+    }
+}
+
+void FRemEditorTickDispatcher::RemoveRegistration(const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey)
+{
+    if (FRegistration Registration;
+        Registrations.RemoveAndCopyValue(ActorKey, Registration))
+    {
+        RemoveDependents(ActorKey, Registration.Dependencies);
+    }
+}
+
+void FRemEditorTickDispatcher::RemoveDependents(const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey,
+    const FRemEditorTickDependencies& Dependencies)
+{
+    for (const auto* Object : Dependencies.Objects)
+    {
+        if (auto* ObjectDependents = Dependents.Find(Object))
+        {
+            ObjectDependents->RemoveSwap(ActorKey);
+
+            if (ObjectDependents->IsEmpty())
+            {
+                Dependents.Remove(Object);
+            }
+        }
+    }
+}
+
+void FRemEditorTickDispatcher::MarkDependentsDirty(const UObject& Object)
+{
+    const auto* ObjectDependents = Dependents.Find(&Object);
+    if (!ObjectDependents)
+    {
+        return;
+    }
+
+    for (const auto& ActorKey : *ObjectDependents)
+    {
+        if (const auto* Actor = ActorKey.ResolveObjectPtr())
+        {
+            MarkDirty(*Actor);
+        }
+    }
+}
+
+void FRemEditorTickDispatcher::WakeParkedActor(const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey)
+{
+    auto* Registration = Registrations.Find(ActorKey);
+    if (!Registration || !Registration->bParked)
+    {
+        return;
+    }
+
+    Registration->bParked = false;
+    ParkedActors.RemoveSwap(ActorKey);
+    DirtyActors.Add(ActorKey);
+}
+
+void FRemEditorTickDispatcher::WakeParkedActors(const TConstArrayView<ERemEditorTickRelevance> Relevances)
+{
+    ParkedActors.RemoveAllSwap([this, &Relevances](const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey)
+    {
+        auto* Registration = Registrations.Find(ActorKey);
+        if (!Registration || !Registration->bParked)
+        {
+            return true;
+        }
+
+        const auto* Actor = Registration->Actor.Get();
+        if (!Actor)
+        {
+            return true;
+        }
+
+        if (!Relevances.Contains(Actor->EditorTickRelevance))
+        {
+            return false;
+        }
+
+        Registration->bParked = false;
+        DirtyActors.Add(ActorKey);
+        return true;
+    });
+}
+
+void FRemEditorTickDispatcher::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+    if (!Object || Registrations.IsEmpty())
+    {
+        return;
+    }
+
+    // own properties, or the ones of its components
+    const auto* OwnerActor = Cast<ARemEditorOnlyTickableActor>(Object);
+    if (!OwnerActor)
+    {
+        OwnerActor = Object->GetTypedOuter<ARemEditorOnlyTickableActor>();
+    }
+
+    if (const auto* Registration = OwnerActor ? Registrations.Find(OwnerActor) : nullptr)
+    {
+        WakeParkedActor(OwnerActor);
+
+        const auto& [Properties, bTransform, Objects] = Registration->Dependencies;
+        if (Properties.IsEmpty()
+            || (Object == OwnerActor && Properties.Contains(PropertyChangedEvent.GetMemberPropertyName()))
+            || (bTransform && Object == OwnerActor->GetRootComponent()))
+        {
+            MarkDirty(*OwnerActor);
+        }
+    }
+
+    MarkDependentsDirty(*Object);
+
+    // components of dependent actors
+    if (const auto* Actor = Object->GetTypedOuter<AActor>())
+    {
+        MarkDependentsDirty(*Actor);
+    }
+}
+
+void FRemEditorTickDispatcher::OnActorMoved(AActor* Actor)
+{
+    if (!Actor || Registrations.IsEmpty())
+    {
+        return;
+    }
+
+    if (const auto* TickableActor = Cast<ARemEditorOnlyTickableActor>(Actor))
+    {
+        WakeParkedActor(TickableActor);
+
+        if (const auto* Registration = Registrations.Find(TickableActor);
+            Registration && Registration->Dependencies.bTransform)
+        {
+            MarkDirty(*TickableActor);
+        }
+    }
+
+    MarkDependentsDirty(*Actor);
+}
+
+void FRemEditorTickDispatcher::OnAssetReimport(UObject* Asset)
+{
+    if (Asset)
+    {
+        MarkDependentsDirty(*Asset);
+    }
+}
+
+void FRemEditorTickDispatcher::OnSelectionChanged(UObject*)
+{
+    WakeParkedActors({ERemEditorTickRelevance::Selected});
+}
+
+void FRemEditorTickDispatcher::OnEditorCameraMoved(const FVector&, const FRotator&, ELevelViewportType, int32)
+{
+    WakeParkedActors({ERemEditorTickRelevance::VisibleInViewport});
+}
+
+void FRemEditorTickDispatcher::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+    // registrations are dropped along with the level, PostActorCreated doesn't run again once it's added back
+    if (Level && World && World->IsEditorWorld())
+    {
+        for (AActor* Actor : Level->Actors)
+        {
+            auto* TickableActor = Cast<ARemEditorOnlyTickableActor>(Actor);
+            if (IsValid(TickableActor) && TickableActor->EditorTickMode == ERemEditorTickMode::OnChange
+                && TickableActor->PrimaryActorTick.bStartWithTickEnabled && !Registrations.Contains(TickableActor))
+            {
+                Register(*TickableActor);
+            }
+        }
+    }
+
+    WakeParkedActors({ERemEditorTickRelevance::LevelVisible, ERemEditorTickRelevance::VisibleInViewport});
+}
+
+void FRemEditorTickDispatcher::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+    if (Registrations.IsEmpty())
+    {
+        return;
+    }
+
+    // no level for the whole world being torn down
+    TArray<TObjectKey<ARemEditorOnlyTickableActor>, TInlineAllocator<16>> RemovedActors;
+    for (const auto& [ActorKey, Registration] : Registrations)
+    {
+        const auto* Actor = Registration.Actor.Get();
+        if (Actor && (Level ? Actor->GetLevel() == Level : Actor->GetWorld() == World))
+        {
+            RemovedActors.Add(ActorKey);
+        }
+    }
+
+    for (const auto& ActorKey : RemovedActors)
+    {
+        RemoveRegistration(ActorKey);
+    }
+
+    WakeParkedActors({ERemEditorTickRelevance::LevelVisible, ERemEditorTickRelevance::VisibleInViewport});
+}
@@ -0,0 +1,132 @@
+// Copyright RemRemRemRe. 2025. All Rights Reserved.
+
+
+#include "RemEditorTickRelevance.h"
+
+#include "Editor.h"
+#include "LevelEditorViewport.h"
+#include "RemEditorOnlyTickableActor.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+TAutoConsoleVariable CVarEditorTickRelevance(TEXT("Rem.Editor.Tickable.Actor.Relevance"), true,
+    TEXT("Skip EditorTick of editor only tickable actors which are not relevant according to their "
+        "EditorTickRelevance, false to tick all of them"));
+}
+
+bool FRemEditorTickRelevance::IsRelevant(const ARemEditorOnlyTickableActor& Actor)
+{
+    if (!CVarEditorTickRelevance.GetValueOnGameThread())
+    {
+        return true;
+    }
+
+    switch (Actor.EditorTickRelevance)
+    {
+    case ERemEditorTickRelevance::Always:
+        return true;
+    case ERemEditorTickRelevance::VisibleInViewport:
+        return IsLevelVisible(Actor) && IsVisibleInAnyViewport(Actor, Actor.EditorTickMaxDistance);
+    case ERemEditorTickRelevance::Selected:
+        return Actor.IsSelected();
+    case ERemEditorTickRelevance::LevelVisible:
+        return IsLevelVisible(Actor);
+    default:
+        checkNoEntry();
+        return true;
+    }
+}
+
+bool FRemEditorTickRelevance::IsLevelVisible(const AActor& Actor)
+{
+    const auto* Level = Actor.GetLevel();
+    return Level && Level->bIsVisible && !Actor.IsHiddenEd();
+}
+
+bool FRemEditorTickRelevance::IsVisibleInAnyViewport(const AActor& Actor, const double MaxDistance)
+{
+    UpdateViews();
+
+    const auto* RootComponent = Actor.GetRootComponent();
+    const FVector Origin  = RootComponent ? RootComponent->Bounds.Origin : Actor.GetActorLocation();
+    const double Radius   = RootComponent ? RootComponent->Bounds.SphereRadius : 0.0;
+
+    for (const auto& [Location, Frustum, bOrthographic] : Views)
+    {
+        if (bOrthographic)
+        {
+            return true;
+        }
+
+        if (MaxDistance > 0.0 && FVector::DistSquared(Location, Origin) > FMath::Square(MaxDistance + Radius))
+        {
+            continue;
+        }
+
+        if (Frustum.IntersectSphere(Origin, Radius))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FRemEditorTickRelevance::UpdateViews()
+{
+    if (ViewsFrame == GFrameCounter)
+    {
+        return;
+    }
+
+    ViewsFrame = GFrameCounter;
+    Views.Reset();
+
+    if (!GEditor)
+    {
+        return;
+    }
+
+    // swap axis from unreal (x forward, z up) to view space (z forward, y up), as FSceneView does
+    static const FMatrix ViewAxisSwap{
+        FPlane{0, 0, 1, 0},
+        FPlane{1, 0, 0, 0},
+        FPlane{0, 1, 0, 0},
+        FPlane{0, 0, 0, 1}
+    };
+
+    for (const auto* ViewportClient : GEditor->GetLevelViewportClients())
+    {
+        if (!ViewportClient || !ViewportClient->Viewport || !ViewportClient->IsVisible())
+        {
+            continue;
+        }
+
+        const FIntPoint ViewportSize = ViewportClient->Viewport->GetSizeXY();
+        if (ViewportSize.X <= 0 || ViewportSize.Y <= 0)
+        {
+            continue;
+        }
+
+        auto& View         = Views.AddDefaulted_GetRef();
+        View.Location      = ViewportClient->GetViewLocation();
+        View.bOrthographic = !ViewportClient->IsPerspective();
+
+        if (View.bOrthographic)
+        {
+            continue;
+        }
+
+        const FMatrix ViewMatrix = FTranslationMatrix{-View.Location}
+                                   * FInverseRotationMatrix{ViewportClient->GetViewRotation()} * ViewAxisSwap;
+        const FMatrix ProjectionMatrix = FReversedZPerspectiveMatrix{
+            FMath::DegreesToRadians(ViewportClient->ViewFOV) * 0.5, static_cast<double>(ViewportSize.X),
+            static_cast<double>(ViewportSize.Y), GNearClippingPlane
+        };
+
+        GetViewFrustumBounds(View.Frustum, ViewMatrix * ProjectionMatrix, false);
+    }
+}
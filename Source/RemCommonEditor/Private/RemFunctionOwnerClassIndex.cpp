@@ -0,0 +1,225 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+
+#include "RemFunctionOwnerClassIndex.h"
+
+#include "ClassViewerFilter.h"
+#include "Editor.h"
+#include "RemCommonEditorLog.h"
+#include "RemCommonEditorStat.h"
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemFunctionSignatureCache.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Macro/RemAssertionMacros.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+TAutoConsoleVariable CVarFunctionOwnerClassIndexTimeBudget(TEXT("Rem.Editor.FunctionOwnerClassIndex.TimeBudgetMs"),
+    2.0f, TEXT("Time budget per frame of indexing function owner classes in background, non-positive disables it"));
+
+TAutoConsoleVariable CVarFunctionOwnerClassIndexIdleSeconds(
+    TEXT("Rem.Editor.FunctionOwnerClassIndex.IdleSeconds"), 1.0f,
+    TEXT("Seconds without user interaction before indexing function owner classes in background"));
+
+bool HasSupportedFunction(const UClass& Class)
+{
+    const auto& SignatureCache = FRemFunctionSignatureCache::Get();
+
+    // the same functions as UClass::GenerateFunctionList, without collecting their names, stop at the first supported
+    for (TFieldIterator<UFunction> It(&Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+    {
+        if (SignatureCache.IsSupported(**It))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool IsEditorIdle()
+{
+    if (!FSlateApplication::IsInitialized())
+    {
+        return false;
+    }
+
+    const auto& SlateApplication = FSlateApplication::Get();
+    return SlateApplication.GetCurrentTime() - SlateApplication.GetLastUserInteractionTime()
+           >= CVarFunctionOwnerClassIndexIdleSeconds.GetValueOnGameThread();
+}
+}
+
+FRemFunctionOwnerClassIndex::FRemFunctionOwnerClassIndex()
+{
+    StartTicker();
+
+    RegisterInvalidation(TEXT("FunctionOwnerClassIndex"),
+        Rem::Editor::EInvalidationReason::ModulesChanged | Rem::Editor::EInvalidationReason::CodeReloaded,
+        Rem::Editor::FOnInvalidated::CreateLambda([this](const Rem::Editor::EInvalidationReason Reasons)
+        {
+            // any native class could be patched, and there is no telling which
+            if (EnumHasAnyFlags(Reasons, Rem::Editor::EInvalidationReason::CodeReloaded))
+            {
+                Reset();
+            }
+
+            // indexed classes stay valid, only the pending classes miss the new ones
+            bPendingClassesGathered = false;
+            StartTicker();
+        }));
+
+    // the blueprint class is compiled in place, its functions are about to change
+    if (GEditor)
+    {
+        OnBlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddLambda([this](const UBlueprint* Blueprint)
+        {
+            if (Blueprint)
+            {
+                Remove(Blueprint->GeneratedClass);
+                Remove(Blueprint->SkeletonGeneratedClass);
+            }
+        });
+    }
+
+    OnObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda(
+        [this](const TMap<UObject*, UObject*>& OldToNewObjects)
+        {
+            for (const auto& [OldObject, NewObject] : OldToNewObjects)
+            {
+                Remove(Cast<UClass>(OldObject));
+                Remove(Cast<UClass>(NewObject));
+            }
+        });
+
+    RegisterMemReport(TEXT("FunctionOwnerClassIndex"),
+        Rem::Editor::FMemReportProvider::CreateLambda([this](TArray<Rem::Editor::FMemReportEntry>& OutEntries)
+        {
+            OutEntries.Add({TEXT("Classes"), SupportedClasses.Num(), SupportedClasses.GetAllocatedSize()});
+            OutEntries.Add({TEXT("PendingClasses"), PendingClasses.Num(), PendingClasses.GetAllocatedSize()});
+        }));
+}
+
+FRemFunctionOwnerClassIndex::~FRemFunctionOwnerClassIndex()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    if (GEditor)
+    {
+        GEditor->OnBlueprintPreCompile().Remove(OnBlueprintPreCompileHandle);
+    }
+
+    FCoreUObjectDelegates::OnObjectsReinstanced.Remove(OnObjectsReinstancedHandle);
+}
+
+bool FRemFunctionOwnerClassIndex::HasSupportedFunctions(const UClass& Class)
+{
+    if (const bool* bSupported = SupportedClasses.Find(&Class))
+    {
+        return *bSupported;
+    }
+
+    LLM_SCOPE_BYTAG(RemCommonEditor);
+
+    return SupportedClasses.Add(&Class, HasSupportedFunction(Class));
+}
+
+bool FRemFunctionOwnerClassIndex::HasSupportedFunctions(const IUnloadedBlueprintData& UnloadedClassData)
+{
+    const auto* AssetRegistry = IAssetRegistry::Get();
+    RemCheckVariable(AssetRegistry, return true;);
+
+    // "/Game/BP_Foo.BP_Foo_C" is generated by "/Game/BP_Foo.BP_Foo"
+    const auto ClassPath = UnloadedClassData.GetClassPathName();
+    FString BlueprintName = ClassPath.GetAssetName().ToString();
+    BlueprintName.RemoveFromEnd(TEXT("_C"));
+
+    const auto AssetData = AssetRegistry->GetAssetByObjectPath(
+        FSoftObjectPath{FTopLevelAssetPath{ClassPath.GetPackageName(), FName{BlueprintName}}});
+
+    FString IsDataOnly;
+    if (!AssetData.IsValid() || !AssetData.GetTagValue(FBlueprintTags::IsDataOnly, IsDataOnly))
+    {
+        // not sure, let it pass
+        return true;
+    }
+
+    // functions are not listed in asset registry, only a data only blueprint is known to declare nothing
+    return !IsDataOnly.ToBool();
+}
+
+void FRemFunctionOwnerClassIndex::Reset()
+{
+    SupportedClasses.Reset();
+    PendingClasses.Reset();
+    bPendingClassesGathered = false;
+    StartTicker();
+}
+
+void FRemFunctionOwnerClassIndex::Remove(const UClass* Class)
+{
+    // indexed again on demand, the signature cache drops its descriptors of the class on its own
+    if (Class)
+    {
+        SupportedClasses.Remove(Class);
+    }
+}
+
+void FRemFunctionOwnerClassIndex::StartTicker()
+{
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &ThisClass::Tick));
+    }
+}
+
+bool FRemFunctionOwnerClassIndex::Tick(float DeltaTime)
+{
+    const double TimeBudget = CVarFunctionOwnerClassIndexTimeBudget.GetValueOnGameThread() / 1000.0;
+    if (TimeBudget <= 0.0 || !IsEditorIdle())
+    {
+        return true;
+    }
+
+    if (!bPendingClassesGathered)
+    {
+        bPendingClassesGathered = true;
+
+        for (TObjectIterator<UClass> It; It; ++It)
+        {
+            if (!SupportedClasses.Contains(*It))
+            {
+                PendingClasses.Emplace(*It);
+            }
+        }
+
+        UE_LOG(LogRemCommonEditor, Verbose, TEXT("Indexing %d function owner classes in background"),
+            PendingClasses.Num());
+    }
+
+    const double EndTime = FPlatformTime::Seconds() + TimeBudget;
+    while (!PendingClasses.IsEmpty() && FPlatformTime::Seconds() < EndTime)
+    {
+        if (const auto* Class = PendingClasses.Pop(EAllowShrinking::No).Get())
+        {
+            HasSupportedFunctions(*Class);
+        }
+    }
+
+    if (!PendingClasses.IsEmpty())
+    {
+        return true;
+    }
+
+    // done, started again when more classes need indexing
+    PendingClasses.Empty();
+    TickerHandle.Reset();
+
+    return false;
+}
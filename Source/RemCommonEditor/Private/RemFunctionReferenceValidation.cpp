@@ -0,0 +1,447 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+
+#include "RemFunctionReferenceValidation.h"
+
+#include "RemCommonEditorLog.h"
+#include "RemCommonEditorStatics.h"
+#include "RemFunctionSignatureCache.h"
+#include "Algo/AllOf.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Hash/Blake3.h"
+#include "HAL/FileManager.h"
+#include "IO/IoHash.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/StringBuilder.h"
+#include "Serialization/Archive.h"
+#include "Struct/RemReflectedFunctionData.h"
+#include "UObject/Package.h"
+#include "UObject/PropertyIterator.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+/** bump it whenever the checks or the file layout change, to drop results of older scans */
+constexpr int32 ScanCacheVersion = 2;
+
+struct FFunctionReference
+{
+    const UObject* Object{};
+    FString PropertyPath;
+    const FRemReflectedFunctionData* FunctionData{};
+};
+
+/**
+ * @brief Owner class the issues of a package are judged against, results are reused only while it is unchanged
+ */
+struct FOwnerClassDependency
+{
+    FString ClassPath;
+
+    /** saved hash of a blueprint class package, or hash of function names of a native class */
+    FIoHash Hash;
+
+    friend FArchive& operator<<(FArchive& Ar, FOwnerClassDependency& Dependency)
+    {
+        return Ar << Dependency.ClassPath << Dependency.Hash;
+    }
+};
+
+struct FScanCacheEntry
+{
+    FIoHash SavedHash;
+    TArray<FOwnerClassDependency> Dependencies;
+    TArray<FString> Issues;
+};
+
+FString GetScanCacheFilename()
+{
+    return FPaths::ProjectSavedDir() / TEXT("RemCommonEditor") / TEXT("FunctionReferenceScanCache.bin");
+}
+
+TMap<FName, FScanCacheEntry> LoadScanCache()
+{
+    TMap<FName, FScanCacheEntry> Cache;
+
+    const TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*GetScanCacheFilename())};
+    if (!Reader)
+    {
+        return Cache;
+    }
+
+    int32 Version{};
+    int32 NumEntries{};
+    *Reader << Version << NumEntries;
+    if (Version != ScanCacheVersion || NumEntries < 0)
+    {
+        return Cache;
+    }
+
+    Cache.Reserve(NumEntries);
+    for (int32 Index = 0; Index < NumEntries && !Reader->IsError(); ++Index)
+    {
+        FString PackageName;
+        FScanCacheEntry Entry;
+        *Reader << PackageName << Entry.SavedHash << Entry.Dependencies << Entry.Issues;
+
+        Cache.Add(FName{PackageName}, MoveTemp(Entry));
+    }
+
+    if (Reader->IsError())
+    {
+        Cache.Reset();
+    }
+
+    return Cache;
+}
+
+void SaveScanCache(TMap<FName, FScanCacheEntry>& Cache)
+{
+    const TUniquePtr<FArchive> Writer{IFileManager::Get().CreateFileWriter(*GetScanCacheFilename())};
+    if (!Writer)
+    {
+        UE_LOG(LogRemCommonEditor, Warning, TEXT("Can't write %s"), *GetScanCacheFilename());
+        return;
+    }
+
+    int32 Version{ScanCacheVersion};
+    int32 NumEntries{Cache.Num()};
+    *Writer << Version << NumEntries;
+
+    for (auto& [PackageName, Entry] : Cache)
+    {
+        FString PackageNameString = PackageName.ToString();
+        *Writer << PackageNameString << Entry.SavedHash << Entry.Dependencies << Entry.Issues;
+    }
+}
+
+FIoHash GetSavedHash(const IAssetRegistry& AssetRegistry, const FName PackageName)
+{
+    const auto PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+    return FIoHash{PackageData ? PackageData->GetPackageSavedHash() : FIoHash{}};
+}
+
+/**
+ * @param Class the class if it's loaded, unloaded native classes are gone after a code change
+ */
+FIoHash GetOwnerClassHash(const IAssetRegistry& AssetRegistry, const FSoftClassPath& ClassPath, const UClass* Class)
+{
+    const FName PackageName = ClassPath.GetLongPackageFName();
+    if (!FPackageName::IsScriptPackage(PackageName.ToString()))
+    {
+        // without loading the blueprint class
+        return GetSavedHash(AssetRegistry, PackageName);
+    }
+
+    if (!Class)
+    {
+        Class = ClassPath.ResolveClass();
+        if (!Class)
+        {
+            return {};
+        }
+    }
+
+    // native classes are not saved, their function names (including inherited ones) are what the checks rely on
+    FBlake3 Hasher;
+    for (TFieldIterator<UFunction> It(Class); It; ++It)
+    {
+        TStringBuilder<128> FunctionName;
+        It->GetFName().AppendString(FunctionName);
+        Hasher.Update(FunctionName.GetData(), FunctionName.Len() * sizeof(TCHAR));
+    }
+
+    return FIoHash{Hasher.Finalize()};
+}
+
+/**
+ * @brief Blueprint owner classes depend on their blueprint parents too, up to the first native class
+ */
+void AddOwnerClassDependencies(const IAssetRegistry& AssetRegistry, const UClass* OwnerClass,
+    TArray<FOwnerClassDependency>& OutDependencies)
+{
+    for (const UClass* Class = OwnerClass; Class; Class = Class->GetSuperClass())
+    {
+        const FSoftClassPath ClassPath{Class};
+        FString ClassPathString = ClassPath.ToString();
+
+        const bool bAdded = OutDependencies.ContainsByPredicate(
+            [&ClassPathString](const FOwnerClassDependency& Dependency)
+            {
+                return Dependency.ClassPath == ClassPathString;
+            });
+
+        if (!bAdded)
+        {
+            OutDependencies.Add({MoveTemp(ClassPathString), GetOwnerClassHash(AssetRegistry, ClassPath, Class)});
+        }
+
+        if (Class->HasAnyClassFlags(CLASS_Native))
+        {
+            break;
+        }
+    }
+}
+
+bool AreDependenciesUnchanged(const IAssetRegistry& AssetRegistry,
+    const TConstArrayView<FOwnerClassDependency> Dependencies)
+{
+    return Algo::AllOf(Dependencies, [&AssetRegistry](const FOwnerClassDependency& Dependency)
+    {
+        return GetOwnerClassHash(AssetRegistry, FSoftClassPath{Dependency.ClassPath}, nullptr) == Dependency.Hash;
+    });
+}
+
+/**
+ * @brief Objects of the package, game thread only
+ */
+TArray<UObject*> GatherPackageObjects(const UPackage& Package)
+{
+    TArray<UObject*> Objects;
+    GetObjectsWithPackage(&Package, Objects, true, RF_Transient);
+    return Objects;
+}
+
+/**
+ * @brief Collect FRemReflectedFunctionData in the objects, only reads reflection data and raw values, never resolves
+ * object pointers or names of objects, so it could run on worker threads while game thread is waiting
+ */
+void GatherFunctionReferences(const TConstArrayView<UObject*> Objects, TArray<FFunctionReference>& OutReferences)
+{
+    const auto* FunctionDataStruct = FRemReflectedFunctionData::StaticStruct();
+
+    for (const auto* Object : Objects)
+    {
+        for (FPropertyValueIterator It(FStructProperty::StaticClass(), Object->GetClass(), Object); It; ++It)
+        {
+            const auto* StructProperty = static_cast<const FStructProperty*>(It.Key());
+            if (!StructProperty->Struct->IsChildOf(FunctionDataStruct))
+            {
+                continue;
+            }
+
+            It.SkipRecursiveProperty();
+
+            const auto* FunctionData = static_cast<const FRemReflectedFunctionData*>(It.Value());
+            if (!FunctionData->FunctionName.IsNone())
+            {
+                OutReferences.Add({Object, It.GetPropertyPathDebugString(), FunctionData});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check references against FRemFunctionSignatureCache, game thread only
+ */
+void CheckFunctionReferences(const TConstArrayView<FFunctionReference> References, TArray<FString>& OutIssues,
+    TArray<FOwnerClassDependency>* OutDependencies = nullptr)
+{
+    auto& SignatureCache = FRemFunctionSignatureCache::Get();
+    const auto& AssetRegistry = IAssetRegistry::GetChecked();
+
+    for (const auto& [Object, PropertyPath, FunctionData] : References)
+    {
+        const UClass* OwnerClass = FunctionData->FunctionOwnerClass;
+        const FName FunctionName = FunctionData->FunctionName;
+
+        if (!OwnerClass)
+        {
+            OutIssues.Add(FString::Printf(TEXT("%s.%s: function \"%s\" has no owner class"),
+                *Object->GetPathName(), *PropertyPath, *FunctionName.ToString()));
+            continue;
+        }
+
+        if (OutDependencies)
+        {
+            AddOwnerClassDependencies(AssetRegistry, OwnerClass, *OutDependencies);
+        }
+
+        if (!SignatureCache.Find(OwnerClass, FunctionName))
+        {
+            OutIssues.Add(FString::Printf(TEXT("%s.%s: function \"%s\" doesn't exist on %s"),
+                *Object->GetPathName(), *PropertyPath, *FunctionName.ToString(), *OwnerClass->GetPathName()));
+        }
+    }
+}
+
+/**
+ * @brief Whether a value of the struct could hold FRemReflectedFunctionData, walking the same properties
+ * FPropertyValueIterator does
+ */
+bool CanHoldFunctionData(const UStruct& Struct, TSet<const UStruct*>& VisitedStructs);
+
+bool CanHoldFunctionData(const FProperty* Property, TSet<const UStruct*>& VisitedStructs)
+{
+    if (const auto* StructProperty = CastField<FStructProperty>(Property))
+    {
+        return StructProperty->Struct->IsChildOf(FRemReflectedFunctionData::StaticStruct())
+               || CanHoldFunctionData(*StructProperty->Struct, VisitedStructs);
+    }
+
+    if (const auto* ArrayProperty = CastField<FArrayProperty>(Property))
+    {
+        return CanHoldFunctionData(ArrayProperty->Inner, VisitedStructs);
+    }
+
+    if (const auto* SetProperty = CastField<FSetProperty>(Property))
+    {
+        return CanHoldFunctionData(SetProperty->ElementProp, VisitedStructs);
+    }
+
+    if (const auto* MapProperty = CastField<FMapProperty>(Property))
+    {
+        return CanHoldFunctionData(MapProperty->KeyProp, VisitedStructs)
+               || CanHoldFunctionData(MapProperty->ValueProp, VisitedStructs);
+    }
+
+    return false;
+}
+
+bool CanHoldFunctionData(const UStruct& Struct, TSet<const UStruct*>& VisitedStructs)
+{
+    bool bVisited{};
+    VisitedStructs.Add(&Struct, &bVisited);
+    if (bVisited)
+    {
+        return false;
+    }
+
+    for (TFieldIterator<FProperty> It(&Struct); It; ++It)
+    {
+        if (CanHoldFunctionData(*It, VisitedStructs))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+}
+
+namespace Rem::CommonEditor
+{
+
+bool CanHoldFunctionReferences(const UPackage& Package)
+{
+    TSet<const UStruct*> VisitedStructs;
+    for (const auto* Object : GatherPackageObjects(Package))
+    {
+        if (CanHoldFunctionData(*Object->GetClass(), VisitedStructs))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FindStaleFunctionReferences(const UPackage& Package, TArray<FString>& OutIssues)
+{
+    TArray<FFunctionReference> References;
+    GatherFunctionReferences(GatherPackageObjects(Package), References);
+    CheckFunctionReferences(References, OutIssues);
+}
+
+FRemFunctionReferenceScanResult ScanStaleFunctionReferences(const TConstArrayView<FName> PackagePaths,
+    const int32 BatchSize, const bool bUseCache)
+{
+    FRemFunctionReferenceScanResult Result;
+    const double StartTime = FPlatformTime::Seconds();
+
+    const auto& AssetRegistry = IAssetRegistry::GetChecked();
+
+    const TArray<FName> PackageNames = GatherPackageNames(PackagePaths);
+    Result.NumPackagesFound          = PackageNames.Num();
+
+    auto Cache = LoadScanCache();
+
+    // deleted or renamed packages never come back under the same saved hash
+    for (auto It = Cache.CreateIterator(); It; ++It)
+    {
+        if (!AssetRegistry.GetAssetPackageDataCopy(It.Key()))
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TArray<FName> PackagesToCheck;
+    TMap<FName, FIoHash> SavedHashesToCheck;
+    for (const auto& PackageName : PackageNames)
+    {
+        const FIoHash SavedHash = GetSavedHash(AssetRegistry, PackageName);
+
+        const auto* Entry = Cache.Find(PackageName);
+        if (bUseCache && Entry && !SavedHash.IsZero() && Entry->SavedHash == SavedHash
+            && AreDependenciesUnchanged(AssetRegistry, Entry->Dependencies))
+        {
+            if (!Entry->Issues.IsEmpty())
+            {
+                Result.Issues.Add(PackageName, Entry->Issues);
+            }
+            continue;
+        }
+
+        // hash is filled after checking, so a package failed to load is never reused
+        Cache.Add(PackageName, {});
+        SavedHashesToCheck.Add(PackageName, SavedHash);
+        PackagesToCheck.Add(PackageName);
+    }
+
+    TArray<TArray<UObject*>> PackageObjects;
+    TArray<TArray<FFunctionReference>> PackageReferences;
+
+    ForEachPackageBatch(PackagesToCheck, BatchSize, [&](const TConstArrayView<UPackage*> Packages)
+    {
+        PackageObjects.Reset();
+        PackageReferences.Reset();
+        PackageReferences.SetNum(Packages.Num());
+
+        for (const auto* Package : Packages)
+        {
+            PackageObjects.Add(GatherPackageObjects(*Package));
+        }
+
+        ParallelFor(Packages.Num(), [&](const int32 Index)
+        {
+            GatherFunctionReferences(PackageObjects[Index], PackageReferences[Index]);
+        });
+
+        for (int32 Index = 0; Index < Packages.Num(); ++Index)
+        {
+            const FName PackageName = Packages[Index]->GetFName();
+
+            auto& Entry     = Cache.FindOrAdd(PackageName);
+            Entry.SavedHash = SavedHashesToCheck.FindRef(PackageName);
+            Entry.Dependencies.Reset();
+            Entry.Issues.Reset();
+            CheckFunctionReferences(PackageReferences[Index], Entry.Issues, &Entry.Dependencies);
+
+            if (!Entry.Issues.IsEmpty())
+            {
+                Result.Issues.Add(PackageName, Entry.Issues);
+            }
+        }
+
+        Result.NumPackagesChecked += Packages.Num();
+        UE_LOG(LogRemCommonEditor, Display, TEXT("Checked %d/%d packages for stale function references"),
+            Result.NumPackagesChecked, PackagesToCheck.Num());
+
+        if (IsRunningCommandlet())
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+
+        return true;
+    });
+
+    SaveScanCache(Cache);
+
+    Result.Seconds = FPlatformTime::Seconds() - StartTime;
+    return Result;
+}
+
+}
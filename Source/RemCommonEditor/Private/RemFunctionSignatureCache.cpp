@@ -0,0 +1,191 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+
+#include "RemFunctionSignatureCache.h"
+
+#include "RemCommonEditorStat.h"
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "Misc/StringBuilder.h"
+#include "Struct/RemReflectedFunctionCallData.h"
+#include "UObject/UnrealType.h"
+
+FRemFunctionSignatureCache::FRemFunctionSignatureCache()
+{
+    using namespace Rem::Editor;
+
+    RegisterInvalidation(TEXT("FunctionSignatureCache"),
+        EInvalidationReason::ReflectionChanged, FOnInvalidated::CreateLambda([this](EInvalidationReason)
+        {
+            Reset();
+        }));
+
+    RegisterMemReport(TEXT("FunctionSignatureCache"), FMemReportProvider::CreateLambda(
+        [this](TArray<FMemReportEntry>& OutEntries)
+        {
+            int64 NumParameters{};
+            SIZE_T Bytes{Descriptors.GetAllocatedSize()};
+
+            for (const auto& [Function, Descriptor] : Descriptors)
+            {
+                NumParameters += Descriptor.Parameters.Num();
+                Bytes += Descriptor.Parameters.GetAllocatedSize();
+
+                if (Descriptor.FilledCallData)
+                {
+                    Bytes += sizeof(FRemReflectedFunctionCallData);
+                }
+
+                for (const auto& Parameter : Descriptor.Parameters)
+                {
+                    Bytes += Parameter.DefaultValue.GetAllocatedSize();
+                }
+            }
+
+            OutEntries.Add({TEXT("Descriptors"), Descriptors.Num(), Bytes});
+            OutEntries.Add({TEXT("Parameters"), NumParameters, 0});
+        }));
+}
+
+const FRemFunctionSignatureDescriptor* FRemFunctionSignatureCache::Find(const UClass* OwnerClass,
+    const FName FunctionName)
+{
+    if (!OwnerClass || FunctionName.IsNone())
+    {
+        return nullptr;
+    }
+
+    const auto* Function = OwnerClass->FindFunctionByName(FunctionName);
+    return Function ? &FindOrAdd(*Function) : nullptr;
+}
+
+const FRemFunctionSignatureDescriptor& FRemFunctionSignatureCache::FindOrAdd(const UFunction& Function)
+{
+    if (const auto* Descriptor = Descriptors.Find(&Function))
+    {
+        return *Descriptor;
+    }
+
+    LLM_SCOPE_BYTAG(RemCommonEditor);
+
+    return Descriptors.Add(&Function, MakeDescriptor(Function));
+}
+
+bool FRemFunctionSignatureCache::IsSupported(const UFunction& Function) const
+{
+    if (const auto* Descriptor = Descriptors.Find(&Function))
+    {
+        return Descriptor->bSupported;
+    }
+
+    // on stack, the caller only wants the flag
+    FRemReflectedFunctionCallData ScratchCallData;
+    return FillCallData(Function, ScratchCallData);
+}
+
+void FRemFunctionSignatureCache::FillParameters(FRemReflectedFunctionCallData& CallData)
+{
+    const auto* Descriptor = Find(CallData.FunctionData.FunctionOwnerClass, CallData.FunctionData.FunctionName);
+    if (!Descriptor || !Descriptor->FilledCallData)
+    {
+        // no function to take the parameters from, let the runtime struct clear them
+        CallData.TryFillParameters();
+        return;
+    }
+
+    // the function data is picked by the user (eg: owner class could be a child class of the function owner)
+    static const FName FunctionDataName = GET_MEMBER_NAME_CHECKED(FRemReflectedFunctionCallData, FunctionData);
+    for (TFieldIterator<FProperty> It(FRemReflectedFunctionCallData::StaticStruct()); It; ++It)
+    {
+        if (It->GetFName() != FunctionDataName)
+        {
+            It->CopyCompleteValue_InContainer(&CallData, Descriptor->FilledCallData.Get());
+        }
+    }
+
+    if (!Descriptor->bSupported)
+    {
+        CallData.FunctionData.FunctionName = NAME_None;
+    }
+}
+
+uint32 FRemFunctionSignatureCache::GetGeneration() const
+{
+    return Generation;
+}
+
+void FRemFunctionSignatureCache::Reset()
+{
+    Descriptors.Reset();
+    ++Generation;
+}
+
+FRemFunctionSignatureDescriptor FRemFunctionSignatureCache::MakeDescriptor(const UFunction& Function)
+{
+    FRemFunctionSignatureDescriptor Descriptor;
+    Descriptor.Function       = &Function;
+    Descriptor.ParametersSize = Function.ParmsSize;
+
+    TStringBuilder<256> SignatureString;
+    SignatureString << Function.GetFName() << TEXT('(');
+
+    for (TFieldIterator<FProperty> It(&Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+    {
+        FProperty* Property = *It;
+
+        if (Property->HasAnyPropertyFlags(CPF_ReturnParm))
+        {
+            Descriptor.ReturnProperty = Property;
+            continue;
+        }
+
+        auto& Parameter     = Descriptor.Parameters.AddDefaulted_GetRef();
+        Parameter.Name      = Property->GetFName();
+        Parameter.Property  = Property;
+        Parameter.Offset    = Property->GetOffset_ForUFunction();
+        Parameter.Size      = Property->GetSize();
+        Parameter.bOutParam = Property->HasAnyPropertyFlags(CPF_OutParm)
+                              && !Property->HasAnyPropertyFlags(CPF_ConstParm | CPF_ReferenceParm);
+
+        TStringBuilder<64> DefaultValueKey;
+        DefaultValueKey << TEXT("CPP_Default_") << Parameter.Name;
+        Parameter.DefaultValue = Function.GetMetaData(DefaultValueKey.ToString());
+
+        if (Descriptor.Parameters.Num() > 1)
+        {
+            SignatureString << TEXT(", ");
+        }
+
+        SignatureString << Property->GetCPPType() << TEXT(' ') << Parameter.Name;
+        if (!Parameter.DefaultValue.IsEmpty())
+        {
+            SignatureString << TEXT(" = ") << Parameter.DefaultValue;
+        }
+    }
+
+    SignatureString << TEXT(')');
+    if (Descriptor.ReturnProperty)
+    {
+        SignatureString << TEXT(" -> ") << Descriptor.ReturnProperty->GetCPPType();
+    }
+
+    Descriptor.SignatureText = FText::FromString(FString{SignatureString.ToView()});
+
+    // keep what the runtime struct filled for every call data picking the function later
+    const auto FilledCallData = MakeShared<FRemReflectedFunctionCallData>();
+
+    Descriptor.bSupported     = FillCallData(Function, *FilledCallData);
+    Descriptor.FilledCallData = FilledCallData;
+
+    return Descriptor;
+}
+
+bool FRemFunctionSignatureCache::FillCallData(const UFunction& Function, FRemReflectedFunctionCallData& OutCallData)
+{
+    // let the runtime struct decide, so the supported flag never goes out of sync with it
+    OutCallData.FunctionData.FunctionOwnerClass = Function.GetOwnerClass();
+    OutCallData.FunctionData.FunctionName       = Function.GetFName();
+    OutCallData.TryFillParameters();
+
+    return !OutCallData.FunctionData.FunctionName.IsNone();
+}
@@ -0,0 +1,36 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+
+#include "Validators/RemFunctionReferenceValidator.h"
+
+#include "RemFunctionReferenceValidation.h"
+#include "UObject/Package.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RemFunctionReferenceValidator)
+
+bool URemFunctionReferenceValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData,
+    UObject* InObject, FDataValidationContext& InContext) const
+{
+    return InObject && InObject->GetPackage()
+           && Rem::CommonEditor::CanHoldFunctionReferences(*InObject->GetPackage());
+}
+
+EDataValidationResult URemFunctionReferenceValidator::ValidateLoadedAsset_Implementation(
+    const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+    TArray<FString> Issues;
+    Rem::CommonEditor::FindStaleFunctionReferences(*InAsset->GetPackage(), Issues);
+
+    for (const auto& Issue : Issues)
+    {
+        AssetFails(InAsset, FText::FromString(Issue));
+    }
+
+    if (Issues.IsEmpty())
+    {
+        AssetPasses(InAsset);
+        return EDataValidationResult::Valid;
+    }
+
+    return EDataValidationResult::Invalid;
+}
@@ -0,0 +1,23 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "RemBulkEditCommandlet.generated.h"
+
+/**
+ * @brief Command line entry of Rem::CommonEditor::BulkEditProperties, eg:
+ * -run=RemBulkEdit -Paths=/Game/UI+/Game/Widgets -Property=OnClicked.FunctionData.FunctionName
+ * -Match=OldFunction -Replace=NewFunction [-BatchSize=64] [-DryRun]
+ */
+UCLASS()
+class URemBulkEditCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URemBulkEditCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,22 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "RemFunctionReferenceValidationCommandlet.generated.h"
+
+/**
+ * @brief Command line entry of Rem::CommonEditor::ScanStaleFunctionReferences, eg:
+ * -run=RemFunctionReferenceValidation [-Paths=/Game/UI+/Game/Widgets] [-BatchSize=64] [-NoCache]
+ */
+UCLASS()
+class URemFunctionReferenceValidationCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URemFunctionReferenceValidationCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
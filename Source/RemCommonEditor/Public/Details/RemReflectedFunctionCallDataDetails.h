@@ -6,6 +6,11 @@
 
 class IPropertyHandleStruct;
 
+namespace Rem::Editor
+{
+struct FMemReportEntry;
+}
+
 class REMCOMMONEDITOR_API FRemReflectedFunctionCallDataDetails : public IPropertyTypeCustomization
 {
     TSharedPtr<IPropertyHandle> FunctionCallDataPropertyHandle;
@@ -13,9 +18,17 @@ class REMCOMMONEDITOR_API FRemReflectedFunctionCallDataDetails : public IPropert
 public:
     using ThisClass = FRemReflectedFunctionCallDataDetails;
 
+    FRemReflectedFunctionCallDataDetails();
+    virtual ~FRemReflectedFunctionCallDataDetails() override;
+
     /** Makes a new instance of this detail layout class for a specific detail view requesting it */
     static TSharedRef<IPropertyTypeCustomization> MakeInstance();
 
+    /**
+     * @brief Live instances, @see Rem::Editor::FMemReport
+     */
+    static void ReportMemory(TArray<Rem::Editor::FMemReportEntry>& OutEntries);
+
 protected:
     virtual void CustomizeHeader(TSharedRef<IPropertyHandle> StructPropertyHandle, FDetailWidgetRow& HeaderRow,
         IPropertyTypeCustomizationUtils& StructCustomizationUtils) override;
@@ -6,19 +6,41 @@
 
 template <typename ItemType>
 class SListView;
+class SComboButton;
+
+namespace Rem::Editor
+{
+class FPooledWidgetOwner;
+class FPropertyWidgetBinding;
+struct FMemReportEntry;
+
+template <typename ItemType>
+class TPersistentPopupContent;
+}
 
 class REMCOMMONEDITOR_API FRemReflectedFunctionDataDetails : public IPropertyTypeCustomization
 {
     TSharedPtr<IPropertyHandle> FunctionDataPropertyHandle;
     TArray<TSharedPtr<FName>> ListViewItems;
 
+    /** pooled widgets of the rows, free again when this customization is dropped */
+    TUniquePtr<Rem::Editor::FPooledWidgetOwner> PooledWidgets;
+
 public:
     using ThisClass         = FRemReflectedFunctionDataDetails;
     using FListViewItemType = decltype(ListViewItems)::ElementType;
 
+    FRemReflectedFunctionDataDetails();
+    virtual ~FRemReflectedFunctionDataDetails() override;
+
     /** Makes a new instance of this detail layout class for a specific detail view requesting it */
     static TSharedRef<IPropertyTypeCustomization> MakeInstance();
 
+    /**
+     * @brief Live instances and their list view items, @see Rem::Editor::FMemReport
+     */
+    static void ReportMemory(TArray<Rem::Editor::FMemReportEntry>& OutEntries);
+
 protected:
     virtual void CustomizeHeader(TSharedRef<IPropertyHandle> StructPropertyHandle, FDetailWidgetRow& HeaderRow,
         IPropertyTypeCustomizationUtils& StructCustomizationUtils) override;
@@ -26,6 +48,24 @@ protected:
         IDetailChildrenBuilder& StructBuilder,
         IPropertyTypeCustomizationUtils& StructCustomizationUtils) override;
 
+    /**
+     * @brief Get the popup of function name combo button, the combo button is pooled and may outlive this
+     * customization, so it only reaches us through the binding, @see Rem::Editor::FPropertyWidgetPool
+     */
+    static TSharedRef<SWidget> GetFunctionNamePopupContent(
+        const TSharedRef<Rem::Editor::FPropertyWidgetBinding>& Binding, const TSharedRef<SComboButton>& ComboButton,
+        Rem::Editor::TPersistentPopupContent<FListViewItemType>& PopupContent);
+
+    /**
+     * @brief Changes whenever the function list could change, eg: owner class changed, or blueprint recompiled
+     */
+    uint32 GetFunctionListVersion() const;
+
+    /**
+     * @brief Signature of the function in list view item, @see FRemFunctionSignatureCache
+     */
+    FText GetFunctionSignatureText(const FListViewItemType& Item) const;
+
     virtual void OnFilterTextChanged(const FText& InFilterText,
         const TSharedRef<IPropertyHandle> FilterTextPropertyHandle,
         const TSharedRef<SListView<FListViewItemType>> WidgetListView);
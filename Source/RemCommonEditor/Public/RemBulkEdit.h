@@ -0,0 +1,83 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+#pragma once
+
+#include "UObject/Object.h"
+
+#include "RemBulkEdit.generated.h"
+
+/**
+ * @brief Set a property of all objects in the assets under some content paths,
+ * eg: migrate every FRemReflectedFunctionCallData to a new function, or every widget reference to a new widget
+ */
+USTRUCT(BlueprintType)
+struct REMCOMMONEDITOR_API FRemBulkEditRequest
+{
+    GENERATED_BODY()
+
+    /** content paths (recursively) to find assets in, eg: "/Game/UI" */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rem|BulkEdit")
+    TArray<FName> PackagePaths;
+
+    /**
+     * path of the property from the object, struct members separated by ".",
+     * eg: "OnClicked.FunctionData.FunctionName"
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rem|BulkEdit")
+    FString PropertyPath;
+
+    /** only edit properties with this value (exported text), empty to edit all of them */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rem|BulkEdit")
+    FString MatchValue;
+
+    /** new value (exported text), eg: object path of the new object */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rem|BulkEdit")
+    FString ReplacementValue;
+
+    /** number of packages loaded together */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rem|BulkEdit", meta = (ClampMin = 1))
+    int32 BatchSize{64};
+
+    /** report what would be edited, without touching anything */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rem|BulkEdit")
+    bool bDryRun{};
+};
+
+USTRUCT(BlueprintType)
+struct REMCOMMONEDITOR_API FRemBulkEditResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rem|BulkEdit")
+    int32 NumPackagesFound{};
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rem|BulkEdit")
+    int32 NumPackagesLoaded{};
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rem|BulkEdit")
+    int32 NumObjectsEdited{};
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rem|BulkEdit")
+    int32 NumPackagesSaved{};
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rem|BulkEdit")
+    float Seconds{};
+
+    /** false if the request is invalid, eg: replacement value can't be imported */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rem|BulkEdit")
+    bool bSucceeded{};
+};
+
+namespace Rem::CommonEditor
+{
+
+/**
+ * @brief Load the packages found by the request in batches, set the property wherever it matches, then save
+ * the dirty packages of each batch. Match and replacement values are imported once per property and copied as typed
+ * values. A FRemReflectedFunctionCallData on the property path gets its parameters refilled
+ * @param Request what to edit
+ * @return statistics of the edit
+ */
+REMCOMMONEDITOR_API FRemBulkEditResult BulkEditProperties(const FRemBulkEditRequest& Request);
+
+}
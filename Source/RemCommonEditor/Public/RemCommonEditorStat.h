@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include "HAL/LowLevelMemTracker.h"
 #include "Stats/Stats.h"
 
 DECLARE_STATS_GROUP(TEXT("RemCommonEditor"), STATGROUP_RemCommonEditor, STATCAT_Advanced);
+
+LLM_DECLARE_TAG_API(RemCommonEditor, REMCOMMONEDITOR_API);
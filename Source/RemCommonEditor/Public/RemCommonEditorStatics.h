@@ -2,17 +2,45 @@
 
 #pragma once
 
+#include "RemBulkEdit.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "RemCommonEditorStatics.generated.h"
 
+class UPackage;
+
 UCLASS()
 class REMCOMMONEDITOR_API URemCommonEditorStatics : public UBlueprintFunctionLibrary
 {
     GENERATED_BODY()
 
+public:
+    /**
+     * @brief Editor scripting entry of Rem::CommonEditor::BulkEditProperties
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rem|BulkEdit")
+    static FRemBulkEditResult BulkEditProperties(const FRemBulkEditRequest& Request);
 };
 
 namespace Rem::CommonEditor
 {
 
+/**
+ * @brief Find all packages having assets under the content paths (recursively), waits for the asset registry
+ * if it is still gathering
+ * @param PackagePaths content paths, eg: "/Game/UI"
+ * @return long package names
+ */
+REMCOMMONEDITOR_API TArray<FName> GatherPackageNames(TConstArrayView<FName> PackagePaths);
+
+/**
+ * @brief Load packages in batches, packages of a batch are loaded asynchronously in parallel,
+ * and the batch is handed over once all of them are done
+ * @param PackageNames long package names
+ * @param BatchSize max number of packages per batch
+ * @param BatchFunction called on game thread with the successfully loaded packages of each batch,
+ * return false to stop loading the rest
+ */
+REMCOMMONEDITOR_API void ForEachPackageBatch(TConstArrayView<FName> PackageNames, int32 BatchSize,
+    TFunctionRef<bool(TConstArrayView<UPackage*> Packages)> BatchFunction);
+
 }
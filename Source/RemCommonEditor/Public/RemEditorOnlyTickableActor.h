@@ -7,6 +7,40 @@
 #include "RemEditorOnlyTickableActor.generated.h"
 
 struct FRemEditorTickableHelper;
+struct FRemEditorTickDependencies;
+class FRemEditorTickDispatcher;
+class FRemEditorTickRelevance;
+
+/**
+ * @brief When EditorTick of an editor only tickable actor runs
+ */
+UENUM(BlueprintType)
+enum class ERemEditorTickMode : uint8
+{
+    /** every tick interval */
+    Interval,
+
+    /** only when any of its dependencies changed, at most once per frame, @see FRemEditorTickDispatcher */
+    OnChange,
+};
+
+/**
+ * @brief When an editor only tickable actor is worth ticking, @see FRemEditorTickRelevance
+ */
+UENUM(BlueprintType)
+enum class ERemEditorTickRelevance : uint8
+{
+    Always,
+
+    /** its level is visible, and its bounds are inside the view of any level editor viewport */
+    VisibleInViewport,
+
+    /** selected in the level editor */
+    Selected,
+
+    /** its level (or world partition cell) is loaded and visible, and the actor isn't hidden in editor */
+    LevelVisible,
+};
 
 UCLASS()
 class REMCOMMONEDITOR_API ARemEditorOnlyTickableActor : public AActor
@@ -17,17 +51,77 @@ class REMCOMMONEDITOR_API ARemEditorOnlyTickableActor : public AActor
     FTimerHandle EditorTickHandle{};
 
 protected:
+    UPROPERTY(EditAnywhere, Category = RemEditorOnlyTickableActor)
+    ERemEditorTickMode EditorTickMode{ERemEditorTickMode::Interval};
+
+    /** own properties EditorTick depends on, empty for any of them */
+    UPROPERTY(EditAnywhere, Category = RemEditorOnlyTickableActor,
+        meta = (EditCondition = "EditorTickMode == ERemEditorTickMode::OnChange", EditConditionHides))
+    TSet<FName> EditorTickDependentProperties;
+
+    UPROPERTY(EditAnywhere, Category = RemEditorOnlyTickableActor,
+        meta = (EditCondition = "EditorTickMode == ERemEditorTickMode::OnChange", EditConditionHides))
+    bool bEditorTickOnTransformChanged{true};
+
+    /** other actors EditorTick depends on, their transform and properties */
+    UPROPERTY(EditAnywhere, Category = RemEditorOnlyTickableActor,
+        meta = (EditCondition = "EditorTickMode == ERemEditorTickMode::OnChange", EditConditionHides))
+    TArray<TObjectPtr<AActor>> EditorTickDependentActors;
+
+    /** assets EditorTick depends on, their properties, and reimport */
+    UPROPERTY(EditAnywhere, Category = RemEditorOnlyTickableActor,
+        meta = (EditCondition = "EditorTickMode == ERemEditorTickMode::OnChange", EditConditionHides))
+    TArray<TObjectPtr<UObject>> EditorTickDependentAssets;
+
+    UPROPERTY(EditAnywhere, Category = RemEditorOnlyTickableActor)
+    ERemEditorTickRelevance EditorTickRelevance{ERemEditorTickRelevance::Always};
+
+    /** max distance to the viewport camera, non-positive for unlimited. Ignored by orthographic viewports */
+    UPROPERTY(EditAnywhere, Category = RemEditorOnlyTickableActor, meta = (Units = "cm",
+        EditCondition = "EditorTickRelevance == ERemEditorTickRelevance::VisibleInViewport", EditConditionHides))
+    float EditorTickMaxDistance{};
+
     ARemEditorOnlyTickableActor();
 
     friend FRemEditorTickableHelper;
+    friend FRemEditorTickDispatcher;
+    friend FRemEditorTickRelevance;
 
     virtual void PostActorCreated() override;
     virtual void Destroyed() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 
     virtual void EditorTick(float DeltaSeconds);
 
+    /**
+     * @brief What EditorTick depends on in OnChange mode, by default the EditorTickDependent* properties
+     */
+    virtual void GatherEditorTickDependencies(FRemEditorTickDependencies& OutDependencies) const;
+
+    /**
+     * @brief Run EditorTick on next frame in OnChange mode, for changes not covered by the dependencies.
+     * Call UpdateEditorTickDependencies instead if the dependencies themselves changed
+     */
+    UFUNCTION(BlueprintCallable, Category = RemEditorOnlyTickableActor, CallInEditor)
+    void MarkEditorTickDirty();
+
+    UFUNCTION(BlueprintCallable, Category = RemEditorOnlyTickableActor)
+    void UpdateEditorTickDependencies();
+
     UFUNCTION(BlueprintImplementableEvent, DisplayName = "EditorTick", Category = RemEditorOnlyTickableActor,
         CallInEditor)
     void BP_EditorTick(float DeltaSeconds);
 
+private:
+    /**
+     * @brief Start the timer or register to FRemEditorTickDispatcher, according to EditorTickMode
+     */
+    void StartEditorTick();
+    void StopEditorTick();
+
+    /**
+     * @brief EditorTick if the actor is relevant this frame, according to EditorTickRelevance
+     */
+    void ConditionalEditorTick(float DeltaSeconds);
 };
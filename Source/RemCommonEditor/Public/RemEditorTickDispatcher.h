@@ -0,0 +1,132 @@
+// Copyright RemRemRemRe. 2025. All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class ARemEditorOnlyTickableActor;
+class ULevel;
+class UWorld;
+enum ELevelViewportType : int;
+enum class ERemEditorTickRelevance : uint8;
+struct FPropertyChangedEvent;
+
+/**
+ * @brief What EditorTick of an actor in OnChange mode depends on
+ */
+struct REMCOMMONEDITOR_API FRemEditorTickDependencies
+{
+    /** own properties (top level, or the member property of a nested change), empty for any of them */
+    TSet<FName> Properties;
+
+    bool bTransform{};
+
+    /** other actors (their transform and properties) or assets (their properties, and reimport) */
+    TArray<const UObject*> Objects;
+};
+
+/**
+ * @brief Runs EditorTick of editor only tickable actors in OnChange mode, only when their dependencies changed.
+ * Engine change notifications are routed to dependent actors through an index, dirty actors are coalesced and ticked
+ * once on next frame, nothing runs while the level is idle. Dirty actors which are not relevant are parked, and only
+ * checked again when the selection, a viewport camera, loaded levels or the actor itself changed,
+ * @see FRemEditorTickRelevance. Actors are unregistered along with their level, and registered again once it's added
+ * back
+ */
+class REMCOMMONEDITOR_API FRemEditorTickDispatcher
+    : public Rem::Editor::TEditorCacheSingleton<FRemEditorTickDispatcher>
+{
+    struct FRegistration
+    {
+        TWeakObjectPtr<ARemEditorOnlyTickableActor> Actor;
+        FRemEditorTickDependencies Dependencies;
+
+        /** FApp::GetCurrentTime of its last EditorTick (or registration), the next one gets the time since */
+        double LastTickTime{};
+        bool bDirty{};
+
+        /** dirty but not relevant, waits in ParkedActors */
+        bool bParked{};
+    };
+
+    TMap<TObjectKey<ARemEditorOnlyTickableActor>, FRegistration> Registrations;
+
+    /** registered actors depending on the object */
+    TMap<TObjectKey<UObject>, TArray<TObjectKey<ARemEditorOnlyTickableActor>>> Dependents;
+
+    TArray<TObjectKey<ARemEditorOnlyTickableActor>> DirtyActors;
+    TArray<TObjectKey<ARemEditorOnlyTickableActor>> ParkedActors;
+
+    /** changes made by the actor to itself during its EditorTick are not taken as new changes */
+    TObjectKey<ARemEditorOnlyTickableActor> TickingActor;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+    FDelegateHandle OnObjectPropertyChangedHandle;
+    FDelegateHandle OnActorMovedHandle;
+    FDelegateHandle OnAssetReimportHandle;
+    FDelegateHandle OnSelectionChangedHandle;
+    FDelegateHandle OnSelectObjectHandle;
+    FDelegateHandle OnEditorCameraMovedHandle;
+    FDelegateHandle OnLevelAddedToWorldHandle;
+    FDelegateHandle OnLevelRemovedFromWorldHandle;
+
+    friend TEditorSingleton<FRemEditorTickDispatcher>;
+
+    FRemEditorTickDispatcher();
+
+public:
+    using ThisClass = FRemEditorTickDispatcher;
+
+    ~FRemEditorTickDispatcher();
+
+    /**
+     * @brief Register the actor (again) with its current dependencies, and mark it dirty
+     */
+    void Register(ARemEditorOnlyTickableActor& Actor);
+
+    /**
+     * @brief Safe to call after the dispatcher is shut down
+     */
+    static void Unregister(const ARemEditorOnlyTickableActor& Actor);
+
+    static bool IsRegistered(const ARemEditorOnlyTickableActor& Actor);
+
+    void MarkDirty(const ARemEditorOnlyTickableActor& Actor);
+
+private:
+    bool Tick(float DeltaTime);
+
+    /**
+     * @brief Gather the dependencies of the actor into the registration and the dependents index, marks nothing dirty
+     */
+    void GatherDependencies(const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey, FRegistration& Registration,
+        const ARemEditorOnlyTickableActor& Actor);
+
+    void RemoveRegistration(const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey);
+    void RemoveDependents(const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey,
+        const FRemEditorTickDependencies& Dependencies);
+    void MarkDependentsDirty(const UObject& Object);
+
+    /**
+     * @brief Queue the parked actor to be checked again on next tick, a change to itself could make it relevant
+     */
+    void WakeParkedActor(const TObjectKey<ARemEditorOnlyTickableActor>& ActorKey);
+
+    /**
+     * @brief Queue parked actors of the relevance policies to be checked again on next tick
+     */
+    void WakeParkedActors(TConstArrayView<ERemEditorTickRelevance> Relevances);
+
+    void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+    void OnActorMoved(AActor* Actor);
+    void OnAssetReimport(UObject* Asset);
+    void OnSelectionChanged(UObject* Object);
+    void OnEditorCameraMoved(const FVector& Location, const FRotator& Rotation, ELevelViewportType ViewportType,
+        int32 ViewIndex);
+    void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+    void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+};
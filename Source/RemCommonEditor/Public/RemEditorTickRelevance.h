@@ -0,0 +1,51 @@
+// Copyright RemRemRemRe. 2025. All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesSingleton.h"
+#include "ConvexVolume.h"
+
+class AActor;
+class ARemEditorOnlyTickableActor;
+
+/**
+ * @brief Whether an editor only tickable actor should tick now, according to its ERemEditorTickRelevance.
+ * Views of level editor viewports are gathered once per frame and shared by all actors, so testing an actor is only
+ * a few plane and distance checks against the bounds of its root component.
+ * Controlled by "Rem.Editor.Tickable.Actor.Relevance"
+ */
+class REMCOMMONEDITOR_API FRemEditorTickRelevance : public Rem::Editor::TEditorSingleton<FRemEditorTickRelevance>
+{
+    struct FViewportView
+    {
+        FVector Location;
+        FConvexVolume Frustum;
+
+        /** orthographic views are taken as seeing everything */
+        bool bOrthographic{};
+    };
+
+    TArray<FViewportView> Views;
+    uint64 ViewsFrame{TNumericLimits<uint64>::Max()};
+
+    friend TEditorSingleton<FRemEditorTickRelevance>;
+
+    FRemEditorTickRelevance() = default;
+
+public:
+    bool IsRelevant(const ARemEditorOnlyTickableActor& Actor);
+
+    /**
+     * @brief Level of the actor is visible (for world partition, the cell is loaded as the actor is),
+     * and the actor isn't hidden in editor
+     */
+    static bool IsLevelVisible(const AActor& Actor);
+
+    /**
+     * @param MaxDistance max distance to the viewport camera, non-positive for unlimited
+     */
+    bool IsVisibleInAnyViewport(const AActor& Actor, double MaxDistance);
+
+private:
+    void UpdateViews();
+};
@@ -0,0 +1,62 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class IUnloadedBlueprintData;
+class UClass;
+
+/**
+ * @brief Whether an owner class declares any function (in the class itself, the same as the function list of
+ * FRemReflectedFunctionData) FRemReflectedFunctionCallData supports.
+ * Loaded classes are indexed in time slices while the editor is idle, and on demand if not indexed yet.
+ * Unloaded blueprint classes are judged by asset registry data, without loading them.
+ * Only the classes of a compiled or reinstanced blueprint are dropped, classes of newly loaded modules get gathered
+ * again, the whole index is dropped on hot reload
+ */
+class REMCOMMONEDITOR_API FRemFunctionOwnerClassIndex
+    : public Rem::Editor::TEditorCacheSingleton<FRemFunctionOwnerClassIndex>
+{
+    TMap<TObjectKey<UClass>, bool> SupportedClasses;
+
+    /** classes waiting to be indexed in background */
+    TArray<TWeakObjectPtr<const UClass>> PendingClasses;
+
+    /** only registered while there are classes to index */
+    FTSTicker::FDelegateHandle TickerHandle;
+    FDelegateHandle OnBlueprintPreCompileHandle;
+    FDelegateHandle OnObjectsReinstancedHandle;
+    bool bPendingClassesGathered{};
+
+    friend TEditorSingleton<FRemFunctionOwnerClassIndex>;
+
+    FRemFunctionOwnerClassIndex();
+
+public:
+    using ThisClass = FRemFunctionOwnerClassIndex;
+
+    ~FRemFunctionOwnerClassIndex();
+
+    /**
+     * @return false only if the class is known to have no supported function, computed right away if it is not
+     * indexed yet
+     */
+    bool HasSupportedFunctions(const UClass& Class);
+
+    /**
+     * @return false only if the unloaded blueprint class is known to have no supported function,
+     * eg: data only blueprint
+     */
+    static bool HasSupportedFunctions(const IUnloadedBlueprintData& UnloadedClassData);
+
+    void Reset();
+
+private:
+    void Remove(const UClass* Class);
+    void StartTicker();
+    bool Tick(float DeltaTime);
+};
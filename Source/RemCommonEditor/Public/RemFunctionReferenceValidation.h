@@ -0,0 +1,51 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+
+class UObject;
+class UPackage;
+
+struct REMCOMMONEDITOR_API FRemFunctionReferenceScanResult
+{
+    int32 NumPackagesFound{};
+
+    /** packages loaded and checked, the rest are unchanged since last scan and reused from the results cache */
+    int32 NumPackagesChecked{};
+
+    /** stale references found, by long package name */
+    TMap<FName, TArray<FString>> Issues;
+
+    double Seconds{};
+};
+
+namespace Rem::CommonEditor
+{
+
+/**
+ * @brief Whether any object of the package is of a type which could hold FRemReflectedFunctionData
+ * (anywhere in structs and containers), judged by reflection data only
+ */
+REMCOMMONEDITOR_API bool CanHoldFunctionReferences(const UPackage& Package);
+
+/**
+ * @brief Find FRemReflectedFunctionData (anywhere in structs and containers) in all objects of the package,
+ * whose FunctionName no longer exists on FunctionOwnerClass
+ * @param Package package to check
+ * @param OutIssues one message per stale reference
+ */
+REMCOMMONEDITOR_API void FindStaleFunctionReferences(const UPackage& Package, TArray<FString>& OutIssues);
+
+/**
+ * @brief FindStaleFunctionReferences for all packages under the content paths, packages of a batch are loaded and
+ * walked in parallel. Results are cached locally by package saved hash and the owner classes referenced, packages
+ * unchanged with their owner classes are not loaded again
+ * @param PackagePaths content paths, eg: "/Game/UI"
+ * @param BatchSize number of packages loaded together
+ * @param bUseCache false to check every package, the cache is still refreshed
+ */
+REMCOMMONEDITOR_API FRemFunctionReferenceScanResult ScanStaleFunctionReferences(TConstArrayView<FName> PackagePaths,
+    int32 BatchSize = 64, bool bUseCache = true);
+
+}
@@ -0,0 +1,103 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "UObject/FieldPath.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class FProperty;
+class UClass;
+class UFunction;
+struct FRemReflectedFunctionCallData;
+
+struct REMCOMMONEDITOR_API FRemFunctionParameterDescriptor
+{
+    FName Name;
+
+    /** resolves to null once the function is recompiled, instead of dangling */
+    TFieldPath<FProperty> Property;
+    int32 Offset{};
+    int32 Size{};
+
+    /** default value from "CPP_Default_" meta data, empty if there is none */
+    FString DefaultValue;
+
+    bool bOutParam{};
+};
+
+/**
+ * @brief Reflected layout of a function, and whether FRemReflectedFunctionCallData supports it
+ */
+struct REMCOMMONEDITOR_API FRemFunctionSignatureDescriptor
+{
+    TWeakObjectPtr<const UFunction> Function;
+    TArray<FRemFunctionParameterDescriptor> Parameters;
+    TFieldPath<FProperty> ReturnProperty;
+    int32 ParametersSize{};
+
+    /** whether FRemReflectedFunctionCallData::TryFillParameters accepts the function */
+    bool bSupported{};
+
+    /** eg: "SetValue(int32 Value = 0) -> bool" */
+    FText SignatureText;
+
+    /** call data of the function, its parameters filled once, @see FRemFunctionSignatureCache::FillParameters */
+    TSharedPtr<const FRemReflectedFunctionCallData> FilledCallData;
+};
+
+/**
+ * @brief Per UFunction cache of FRemFunctionSignatureDescriptor, built on first request.
+ * Cleared on blueprint compile, reinstancing, hot reload and module load, via Rem::Editor::FInvalidationBus
+ */
+class REMCOMMONEDITOR_API FRemFunctionSignatureCache
+    : public Rem::Editor::TEditorCacheSingleton<FRemFunctionSignatureCache>
+{
+    TMap<TObjectKey<UFunction>, FRemFunctionSignatureDescriptor> Descriptors;
+
+    /** increased every time the cache is cleared, so derived data could tell whether it is out of date */
+    uint32 Generation{};
+
+    friend TEditorSingleton<FRemFunctionSignatureCache>;
+
+    FRemFunctionSignatureCache();
+
+public:
+    using ThisClass = FRemFunctionSignatureCache;
+
+    /**
+     * @brief Find the descriptor of the function
+     * @param OwnerClass class owning the function
+     * @param FunctionName name of the function
+     * @return descriptor, nullptr if the function is not found
+     */
+    const FRemFunctionSignatureDescriptor* Find(const UClass* OwnerClass, FName FunctionName);
+
+    const FRemFunctionSignatureDescriptor& FindOrAdd(const UFunction& Function);
+
+    /**
+     * @brief Whether FRemReflectedFunctionCallData supports the function, taken from its descriptor if there is one.
+     * No descriptor is added otherwise, so callers checking many functions don't fill the cache
+     */
+    bool IsSupported(const UFunction& Function) const;
+
+    /**
+     * @brief Fill parameters of the call data by copying them from the descriptor of its function, instead of
+     * reflecting the function again. The function name is reset if it's not supported, like
+     * FRemReflectedFunctionCallData::TryFillParameters does
+     */
+    void FillParameters(FRemReflectedFunctionCallData& CallData);
+
+    uint32 GetGeneration() const;
+
+    void Reset();
+
+private:
+    static FRemFunctionSignatureDescriptor MakeDescriptor(const UFunction& Function);
+
+    /**
+     * @return whether the function is supported
+     */
+    static bool FillCallData(const UFunction& Function, FRemReflectedFunctionCallData& OutCallData);
+};
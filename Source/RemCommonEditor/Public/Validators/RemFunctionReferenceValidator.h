@@ -0,0 +1,23 @@
+// Copyright RemRemRemRe. 2024. All Rights Reserved.
+
+#pragma once
+
+#include "EditorValidatorBase.h"
+
+#include "RemFunctionReferenceValidator.generated.h"
+
+/**
+ * @brief Fail assets having FRemReflectedFunctionData whose function no longer exists on its owner class
+ */
+UCLASS()
+class URemFunctionReferenceValidator : public UEditorValidatorBase
+{
+    GENERATED_BODY()
+
+protected:
+    virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject,
+        FDataValidationContext& InContext) const override;
+
+    virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData,
+        UObject* InAsset, FDataValidationContext& Context) override;
+};
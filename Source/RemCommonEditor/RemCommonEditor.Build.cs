@@ -22,6 +22,9 @@ public class RemCommonEditor : ModuleRules
 				"SlateCore",
 				"InputCore",
                 "UnrealEd",
+				"ClassViewer",
+				"AssetRegistry",
+				"DataValidation",
 				
 				"RemCommon",
 				"RemEditorUtilities",
@@ -9,7 +9,8 @@ bool FRemEditorUtilitiesClassFilter::IsClassAllowed(const FClassViewerInitializa
 {
     return !InClass->HasAnyClassFlags(DisallowedClassFlags) && InFilterFuncs->IfInChildOfClassesSet(DisallowedClasses,
                InClass) != EFilterReturn::Passed
-           && InFilterFuncs->IfInChildOfClassesSet(AllowedClasses, InClass) != EFilterReturn::Failed;
+           && InFilterFuncs->IfInChildOfClassesSet(AllowedClasses, InClass) != EFilterReturn::Failed
+           && (!ClassPredicate || ClassPredicate(*InClass));
 }
 
 bool FRemEditorUtilitiesClassFilter::IsUnloadedClassAllowed(const FClassViewerInitializationOptions& InInitOptions,
@@ -18,5 +19,6 @@ bool FRemEditorUtilitiesClassFilter::IsUnloadedClassAllowed(const FClassViewerIn
 {
     return !InUnloadedClassData->HasAnyClassFlags(DisallowedClassFlags) && InFilterFuncs->IfInChildOfClassesSet(
                DisallowedClasses, InUnloadedClassData) != EFilterReturn::Passed
-           && InFilterFuncs->IfInChildOfClassesSet(AllowedClasses, InUnloadedClassData) != EFilterReturn::Failed;
+           && InFilterFuncs->IfInChildOfClassesSet(AllowedClasses, InUnloadedClassData) != EFilterReturn::Failed
+           && (!UnloadedClassPredicate || UnloadedClassPredicate(*InUnloadedClassData));
 }
@@ -0,0 +1,116 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesAssetEditorCache.h"
+
+#include "Editor.h"
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "Engine/Blueprint.h"
+#include "Macro/RemAssertionMacros.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+
+namespace
+{
+UAssetEditorSubsystem* GetAssetEditorSubsystem()
+{
+    return GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+}
+}
+
+namespace Rem::Editor
+{
+
+FAssetEditorInstanceCache::FAssetEditorInstanceCache()
+{
+    if (auto* AssetEditorSubsystem = GetAssetEditorSubsystem())
+    {
+        OnAssetEditorOpenedHandle = AssetEditorSubsystem->OnAssetEditorOpened().AddRaw(this,
+            &FAssetEditorInstanceCache::OnAssetEditorOpened);
+        OnAssetEditorRequestCloseHandle = AssetEditorSubsystem->OnAssetEditorRequestClose().AddRaw(this,
+            &FAssetEditorInstanceCache::OnAssetEditorRequestClose);
+        OnAssetClosedInEditorHandle = AssetEditorSubsystem->OnAssetClosedInEditor().AddRaw(this,
+            &FAssetEditorInstanceCache::OnAssetClosedInEditor);
+    }
+
+    RegisterInvalidation(TEXT("AssetEditorInstanceCache"),
+        EInvalidationReason::ReflectionChanged, FOnInvalidated::CreateLambda([this](EInvalidationReason)
+        {
+            Reset();
+        }));
+
+    RegisterMemReport(TEXT("AssetEditorInstanceCache"), FMemReportProvider::CreateLambda(
+        [this](TArray<FMemReportEntry>& OutEntries)
+        {
+            OutEntries.Add({TEXT("EditorInstances"), EditorInstances.Num(), EditorInstances.GetAllocatedSize()});
+        }));
+}
+
+FAssetEditorInstanceCache::~FAssetEditorInstanceCache()
+{
+    if (auto* AssetEditorSubsystem = GetAssetEditorSubsystem())
+    {
+        AssetEditorSubsystem->OnAssetEditorOpened().Remove(OnAssetEditorOpenedHandle);
+        AssetEditorSubsystem->OnAssetEditorRequestClose().Remove(OnAssetEditorRequestCloseHandle);
+        AssetEditorSubsystem->OnAssetClosedInEditor().Remove(OnAssetClosedInEditorHandle);
+    }
+
+}
+
+IAssetEditorInstance* FAssetEditorInstanceCache::Find(UClass* Class)
+{
+    if (auto* EditorInstance = EditorInstances.Find(Class))
+    {
+        return *EditorInstance;
+    }
+
+    auto& EditorInstance = EditorInstances.Add(Class, nullptr);
+
+    auto* Blueprint = UBlueprint::GetBlueprintFromClass(Class);
+    RemCheckVariable(Blueprint, return {});
+
+    auto* AssetEditorSubsystem = GetAssetEditorSubsystem();
+    RemCheckVariable(AssetEditorSubsystem, return {});
+
+    EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false);
+    return EditorInstance;
+}
+
+void FAssetEditorInstanceCache::Reset()
+{
+    EditorInstances.Reset();
+}
+
+void FAssetEditorInstanceCache::RemoveEntriesOf(const UObject* Asset)
+{
+    const auto* Blueprint = Cast<UBlueprint>(Asset);
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    for (auto It = EditorInstances.CreateIterator(); It; ++It)
+    {
+        if (const auto* Class = It->Key.ResolveObjectPtr();
+            !Class || Class->ClassGeneratedBy == Blueprint)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FAssetEditorInstanceCache::OnAssetEditorOpened(UObject* Asset)
+{
+    RemoveEntriesOf(Asset);
+}
+
+void FAssetEditorInstanceCache::OnAssetEditorRequestClose(UObject* Asset, EAssetEditorCloseReason CloseReason)
+{
+    RemoveEntriesOf(Asset);
+}
+
+void FAssetEditorInstanceCache::OnAssetClosedInEditor(UObject* Asset, IAssetEditorInstance* AssetEditorInstance)
+{
+    RemoveEntriesOf(Asset);
+}
+
+}
@@ -0,0 +1,231 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesGenerationPass.h"
+
+#include "DetailWidgetRow.h"
+#include "IDetailGroup.h"
+#include "PropertyHandle.h"
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesLog.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesStat.h"
+#include "DetailLayoutBuilder.h"
+#include "HAL/IConsoleManager.h"
+#include "Macro/RemAssertionMacros.h"
+#include "UObject/ObjectKey.h"
+#include "Widgets/Input/SButton.h"
+
+DECLARE_MEMORY_STAT(TEXT("Generation Pass Scratch Memory"), STAT_RemGenerationPassScratchMemory,
+    STATGROUP_RemEditorUtilities);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Generation Passes"), STAT_RemGenerationPasses, STATGROUP_RemEditorUtilities);
+
+namespace
+{
+// no limit by default, projects with self-similar data opt in
+TAutoConsoleVariable CVarGenerationMaxDepth(TEXT("Rem.Editor.Generation.MaxDepth"), 0,
+    TEXT("Max nested struct/container depth of a widget generation pass, non-positive means no limit"));
+
+TAutoConsoleVariable CVarGenerationMaxRows(TEXT("Rem.Editor.Generation.MaxRows"), 0,
+    TEXT("Max rows generated in a widget generation pass, non-positive means no limit"));
+
+Rem::Editor::FGenerationPass* CurrentPass{};
+
+/** property paths expanded on demand, by edited object. Entries of destroyed objects are dropped after GC */
+TMap<TObjectKey<UObject>, TSet<FString>> ExpandedPropertyPaths;
+}
+
+namespace Rem::Editor
+{
+
+FGenerationPass::FGenerationPass()
+    : MaxDepth(CVarGenerationMaxDepth.GetValueOnGameThread())
+    , MaxRows(CVarGenerationMaxRows.GetValueOnGameThread())
+{
+}
+
+FGenerationPass* FGenerationPass::GetCurrent()
+{
+    check(IsInGameThread());
+    return CurrentPass;
+}
+
+bool FGenerationPass::IsDepthExceeded() const
+{
+    return MaxDepth > 0 && Depth > MaxDepth;
+}
+
+bool FGenerationPass::IsRowsExceeded() const
+{
+    return MaxRows > 0 && NumRows >= MaxRows;
+}
+
+void FGenerationPass::ExpandOnDemand(const TSharedRef<IPropertyHandle>& PropertyHandle)
+{
+    TArray<UObject*> OuterObjects;
+    PropertyHandle->GetOuterObjects(OuterObjects);
+    RemCheckCondition(!OuterObjects.IsEmpty(), return;);
+
+    const FString PropertyPath = PropertyHandle->GeneratePathToProperty();
+    for (const auto* Object : OuterObjects)
+    {
+        if (Object)
+        {
+            ExpandedPropertyPaths.FindOrAdd(Object).Add(PropertyPath);
+        }
+    }
+
+    // the customization generating the property is somewhere above it, the next generation pass of its top level
+    // property picks up the expanded path
+    TSharedRef<IPropertyHandle> TopLevelHandle = PropertyHandle;
+    while (const TSharedPtr<IPropertyHandle> ParentHandle = TopLevelHandle->GetParentHandle())
+    {
+        TopLevelHandle = ParentHandle.ToSharedRef();
+    }
+
+    TopLevelHandle->RequestRebuildChildren();
+}
+
+bool FGenerationPass::IsExpandedOnDemand(const IPropertyHandle& PropertyHandle)
+{
+    if (ExpandedPropertyPaths.IsEmpty())
+    {
+        return false;
+    }
+
+    TArray<UObject*> OuterObjects;
+    PropertyHandle.GetOuterObjects(OuterObjects);
+
+    const FString PropertyPath = PropertyHandle.GeneratePathToProperty();
+    for (const auto* Object : OuterObjects)
+    {
+        if (const auto* PropertyPaths = ExpandedPropertyPaths.Find(Object);
+            PropertyPaths && PropertyPaths->Contains(PropertyPath))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FGenerationPass::PruneExpandedPaths()
+{
+    for (auto It = ExpandedPropertyPaths.CreateIterator(); It; ++It)
+    {
+        if (!It->Key.ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FGenerationPass::ReportMemory(TArray<FMemReportEntry>& OutEntries)
+{
+    int64 NumPaths{};
+    SIZE_T Bytes{ExpandedPropertyPaths.GetAllocatedSize()};
+
+    for (const auto& [Object, PropertyPaths] : ExpandedPropertyPaths)
+    {
+        NumPaths += PropertyPaths.Num();
+        Bytes += PropertyPaths.GetAllocatedSize();
+
+        for (const auto& PropertyPath : PropertyPaths)
+        {
+            Bytes += PropertyPath.GetAllocatedSize();
+        }
+    }
+
+    OutEntries.Add({TEXT("ExpandedObjects"), ExpandedPropertyPaths.Num(), Bytes});
+    OutEntries.Add({TEXT("ExpandedPaths"), NumPaths, 0});
+}
+
+FScopedGenerationPass::FScopedGenerationPass()
+{
+    Pass = FGenerationPass::GetCurrent();
+    if (!Pass)
+    {
+        // caches keyed by reflection data are dropped here or on tick, never while a nested pass holds their entries
+        FInvalidationBus::Get().Flush();
+
+        auto& MemStack = FMemStack::Get();
+        ScratchMark.Emplace(MemStack);
+        ScratchByteCountAtStart = MemStack.GetByteCount();
+
+        Pass        = &OwnedPass.Emplace();
+        CurrentPass = Pass;
+
+        INC_DWORD_STAT(STAT_RemGenerationPasses);
+    }
+}
+
+FScopedGenerationPass::~FScopedGenerationPass()
+{
+    if (OwnedPass.IsSet())
+    {
+        CurrentPass = nullptr;
+
+        SET_MEMORY_STAT(STAT_RemGenerationPassScratchMemory,
+            FMemStack::Get().GetByteCount() - ScratchByteCountAtStart);
+
+        // release all scratch data of this pass in one go
+        ScratchMark.Reset();
+    }
+}
+
+FScopedGenerationDepth::FScopedGenerationDepth(FGenerationPass& InPass,
+    const TSharedRef<IPropertyHandle>& PropertyHandle, const int32 InDepthDelta)
+    : Pass(InPass)
+    , DepthDelta(InDepthDelta)
+    , SavedMaxDepth(InPass.MaxDepth)
+    , SavedMaxRows(InPass.MaxRows)
+{
+    Pass.Depth += DepthDelta;
+
+    if (FGenerationPass::IsExpandedOnDemand(*PropertyHandle))
+    {
+        Pass.MaxDepth = 0;
+        Pass.MaxRows  = 0;
+    }
+}
+
+FScopedGenerationDepth::~FScopedGenerationDepth()
+{
+    Pass.Depth -= DepthDelta;
+
+    Pass.MaxDepth = SavedMaxDepth;
+    Pass.MaxRows  = SavedMaxRows;
+}
+
+void AddExpandRemainingRow(IDetailGroup& Group, const TSharedRef<IPropertyHandle>& PropertyHandle,
+    const int32 NumRemaining, const EGenerationGuardrail Guardrail)
+{
+    UE_LOG(LogRemEditorUtilities, Log, TEXT("%s guardrail hit at %s, %d items are generated on demand"),
+        Guardrail == EGenerationGuardrail::Depth ? TEXT("Depth") : TEXT("Rows"),
+        *PropertyHandle->GeneratePathToProperty(), NumRemaining);
+
+    const FText ExpandText = FText::Format(
+        NSLOCTEXT("RemEditorUtilities", "ExpandRemaining", "Expand remaining ({0} items)"), NumRemaining);
+
+    Group.AddWidgetRow()
+        .NameContent()
+        [
+            SNew(STextBlock)
+            .Text(PropertyHandle->GetPropertyDisplayName())
+            .Font(IDetailLayoutBuilder::GetDetailFont())
+        ]
+        .ValueContent()
+        [
+            SNew(SButton)
+            .Text(ExpandText)
+            .OnClicked_Lambda([WeakPropertyHandle = PropertyHandle.ToWeakPtr()]
+            {
+                if (const auto PinnedPropertyHandle = WeakPropertyHandle.Pin())
+                {
+                    FGenerationPass::ExpandOnDemand(PinnedPropertyHandle.ToSharedRef());
+                }
+                return FReply::Handled();
+            })
+        ];
+}
+
+}
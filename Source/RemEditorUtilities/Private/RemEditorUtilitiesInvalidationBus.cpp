@@ -0,0 +1,237 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesInvalidationBus.h"
+
+#include "Editor.h"
+#include "RemEditorUtilitiesStat.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/OutputDevice.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache Invalidations"), STAT_RemCacheInvalidations,
+    STATGROUP_RemEditorUtilities);
+
+namespace
+{
+TAutoConsoleVariable CVarInvalidationCoalesce(TEXT("Rem.Editor.Invalidation.Coalesce"), true,
+    TEXT("Coalesce invalidation events of a frame into one call per cache on next tick, "
+        "false to dispatch every engine event right away"));
+
+FAutoConsoleCommandWithOutputDevice InvalidationStatsCommand(TEXT("Rem.Editor.Invalidation.Stats"),
+    TEXT("Print how often each editor cache is invalidated"),
+    FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+    {
+        Rem::Editor::FInvalidationBus::Get().DumpStats(Ar);
+    }));
+
+}
+
+namespace Rem::Editor
+{
+
+FInvalidationBus::FInvalidationBus()
+{
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FInvalidationBus::Tick));
+
+    if (GEditor)
+    {
+        BindEditorDelegates();
+    }
+    else
+    {
+        OnPostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FInvalidationBus::BindEditorDelegates);
+    }
+
+    OnObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda(
+        [this](const TMap<UObject*, UObject*>&)
+        {
+            Invalidate(EInvalidationReason::ObjectsReinstanced);
+        });
+
+    // broadcast by both hot reload and live coding
+    OnReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda(
+        [this](EReloadCompleteReason)
+        {
+            Invalidate(EInvalidationReason::CodeReloaded);
+        });
+
+    if (auto* AssetRegistry = IAssetRegistry::Get())
+    {
+        OnAssetRenamedHandle = AssetRegistry->OnAssetRenamed().AddRaw(this, &FInvalidationBus::OnAssetRenamed);
+        OnAssetRemovedHandle = AssetRegistry->OnAssetRemoved().AddRaw(this, &FInvalidationBus::OnAssetRemoved);
+    }
+
+    OnModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this,
+        &FInvalidationBus::OnModulesChanged);
+}
+
+FInvalidationBus::~FInvalidationBus()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    FCoreDelegates::OnPostEngineInit.Remove(OnPostEngineInitHandle);
+
+    if (GEditor)
+    {
+        GEditor->OnBlueprintCompiled().Remove(OnBlueprintCompiledHandle);
+        GEditor->OnBlueprintReinstanced().Remove(OnBlueprintReinstancedHandle);
+    }
+
+    FCoreUObjectDelegates::OnObjectsReinstanced.Remove(OnObjectsReinstancedHandle);
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(OnReloadCompleteHandle);
+
+    if (auto* AssetRegistry = IAssetRegistry::Get())
+    {
+        AssetRegistry->OnAssetRenamed().Remove(OnAssetRenamedHandle);
+        AssetRegistry->OnAssetRemoved().Remove(OnAssetRemovedHandle);
+    }
+
+    FModuleManager::Get().OnModulesChanged().Remove(OnModulesChangedHandle);
+}
+
+FDelegateHandle FInvalidationBus::Register(const FName CacheName, const EInvalidationReason Reasons,
+    FOnInvalidated Delegate)
+{
+    const FDelegateHandle Handle{FDelegateHandle::GenerateNewHandle};
+    Registrations.Add({Handle, CacheName, Reasons, MoveTemp(Delegate)});
+    Counters.FindOrAdd(CacheName);
+
+    return Handle;
+}
+
+void FInvalidationBus::Unregister(FDelegateHandle& Handle)
+{
+    if (auto* Bus = TryGet();
+        Bus && Handle.IsValid())
+    {
+        Bus->Registrations.RemoveAll([&Handle](const FRegistration& Registration)
+        {
+            return Registration.Handle == Handle;
+        });
+    }
+
+    Handle.Reset();
+}
+
+void FInvalidationBus::Invalidate(const EInvalidationReason Reasons)
+{
+    if (Reasons == EInvalidationReason::None)
+    {
+        return;
+    }
+
+    for (const auto& Registration : Registrations)
+    {
+        if (EnumHasAnyFlags(Registration.Reasons, Reasons))
+        {
+            ++Counters.FindChecked(Registration.CacheName).NumEvents;
+        }
+    }
+
+    PendingReasons |= Reasons;
+    ++NumPendingEvents;
+
+    if (!CVarInvalidationCoalesce.GetValueOnGameThread())
+    {
+        Flush();
+    }
+}
+
+void FInvalidationBus::Flush()
+{
+    if (PendingReasons == EInvalidationReason::None)
+    {
+        return;
+    }
+
+    const auto Reasons = PendingReasons;
+    PendingReasons     = EInvalidationReason::None;
+    NumPendingEvents   = 0;
+
+    // caches could register or unregister while being invalidated
+    const auto RegistrationsToNotify = Registrations;
+    for (const auto& [Handle, CacheName, CacheReasons, Delegate] : RegistrationsToNotify)
+    {
+        const auto MaskedReasons = Reasons & CacheReasons;
+        if (MaskedReasons == EInvalidationReason::None)
+        {
+            continue;
+        }
+
+        const bool bStillRegistered = Registrations.ContainsByPredicate([&Handle](const FRegistration& Registration)
+        {
+            return Registration.Handle == Handle;
+        });
+
+        if (bStillRegistered)
+        {
+            INC_DWORD_STAT(STAT_RemCacheInvalidations);
+
+            ++Counters.FindChecked(CacheName).NumInvalidations;
+            Delegate.ExecuteIfBound(MaskedReasons);
+        }
+    }
+}
+
+void FInvalidationBus::DumpStats(FOutputDevice& Ar) const
+{
+    Ar.Logf(TEXT("%-48s %12s %12s"), TEXT("Cache"), TEXT("Invalidated"), TEXT("Events"));
+
+    for (const auto& [CacheName, CacheCounters] : Counters)
+    {
+        Ar.Logf(TEXT("%-48s %12d %12d"), *CacheName.ToString(), CacheCounters.NumInvalidations,
+            CacheCounters.NumEvents);
+    }
+
+    Ar.Logf(TEXT("%d registrations, %d events pending"), Registrations.Num(), NumPendingEvents);
+}
+
+void FInvalidationBus::BindEditorDelegates()
+{
+    FCoreDelegates::OnPostEngineInit.Remove(OnPostEngineInitHandle);
+    OnPostEngineInitHandle.Reset();
+
+    // not an editor, eg: commandlet without editor engine
+    if (!GEditor || OnBlueprintCompiledHandle.IsValid())
+    {
+        return;
+    }
+
+    OnBlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([this]
+    {
+        Invalidate(EInvalidationReason::BlueprintCompiled);
+    });
+
+    OnBlueprintReinstancedHandle = GEditor->OnBlueprintReinstanced().AddLambda([this]
+    {
+        Invalidate(EInvalidationReason::ObjectsReinstanced);
+    });
+}
+
+bool FInvalidationBus::Tick(float DeltaTime)
+{
+    Flush();
+    return true;
+}
+
+void FInvalidationBus::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    Invalidate(EInvalidationReason::AssetRenamed);
+}
+
+void FInvalidationBus::OnAssetRemoved(const FAssetData& AssetData)
+{
+    Invalidate(EInvalidationReason::AssetRemoved);
+}
+
+void FInvalidationBus::OnModulesChanged(const FName ModuleName, const EModuleChangeReason ChangeReason)
+{
+    if (ChangeReason == EModuleChangeReason::ModuleLoaded || ChangeReason == EModuleChangeReason::ModuleUnloaded)
+    {
+        Invalidate(EInvalidationReason::ModulesChanged);
+    }
+}
+
+}
@@ -0,0 +1,6 @@
+﻿// Copyright RemRemRemRe, All Rights Reserved.
+
+
+#include "RemEditorUtilitiesLog.h"
+
+DEFINE_LOG_CATEGORY(LogRemEditorUtilities)
@@ -0,0 +1,85 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesMemReport.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+namespace
+{
+FAutoConsoleCommandWithOutputDevice MemReportCommand(TEXT("Rem.Editor.MemReport"),
+    TEXT("Print live customization instances, list items, cached indices and pooled widgets, "
+        "and the change since the previous report"),
+    FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+    {
+        Rem::Editor::FMemReport::Get().Dump(Ar);
+    }));
+
+}
+
+namespace Rem::Editor
+{
+
+FDelegateHandle FMemReport::Register(const FName OwnerName, FMemReportProvider Provider)
+{
+    const FDelegateHandle Handle{FDelegateHandle::GenerateNewHandle};
+    Registrations.Add({Handle, OwnerName, MoveTemp(Provider)});
+
+    return Handle;
+}
+
+void FMemReport::Unregister(FDelegateHandle& Handle)
+{
+    if (auto* Report = TryGet();
+        Report && Handle.IsValid())
+    {
+        Report->Registrations.RemoveAll([&Handle](const FRegistration& Registration)
+        {
+            return Registration.Handle == Handle;
+        });
+    }
+
+    Handle.Reset();
+}
+
+void FMemReport::Dump(FOutputDevice& Ar)
+{
+    Ar.Logf(TEXT("%-64s %10s %10s %12s"), TEXT("Entry"), TEXT("Count"), TEXT("Change"), TEXT("KiB"));
+
+    TMap<FString, int64> Counts;
+    SIZE_T TotalBytes{};
+
+    TArray<FMemReportEntry> Entries;
+    for (const auto& [Handle, OwnerName, Provider] : Registrations)
+    {
+        Entries.Reset();
+        Provider.ExecuteIfBound(Entries);
+
+        for (const auto& [Name, Count, Bytes] : Entries)
+        {
+            auto Key = FString::Printf(TEXT("%s.%s"), *OwnerName.ToString(), *Name);
+            const int64* PreviousCount = PreviousCounts.Find(Key);
+
+            Ar.Logf(TEXT("%-64s %10lld %+10lld %12.1f"), *Key, Count, PreviousCount ? Count - *PreviousCount : Count,
+                Bytes / 1024.0);
+
+            TotalBytes += Bytes;
+            Counts.Add(MoveTemp(Key), Count);
+        }
+    }
+
+    // entries gone since the previous report, eg: a pool key no longer used
+    for (const auto& [Key, PreviousCount] : PreviousCounts)
+    {
+        if (!Counts.Contains(Key))
+        {
+            Ar.Logf(TEXT("%-64s %10d %+10lld %12.1f"), *Key, 0, -PreviousCount, 0.0);
+        }
+    }
+
+    Ar.Logf(TEXT("%d providers, %.1f KiB in total"), Registrations.Num(), TotalBytes / 1024.0);
+
+    PreviousCounts = MoveTemp(Counts);
+}
+
+}
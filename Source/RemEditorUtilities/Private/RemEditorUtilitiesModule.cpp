@@ -2,8 +2,23 @@
 
 #include "RemEditorUtilitiesModule.h"
 
+#include "RemEditorUtilitiesAssetEditorCache.h"
+#include "RemEditorUtilitiesGenerationPass.h"
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesPropertyLayoutCache.h"
+#include "RemEditorUtilitiesPropertyPathCache.h"
+#include "RemEditorUtilitiesStartupTimer.h"
+#include "RemEditorUtilitiesWidgetNameResolver.h"
+#include "RemEditorUtilitiesWidgetPool.h"
+#include "RemEditorUtilitiesWidgetTreeIndex.h"
+#include "UObject/UObjectGlobals.h"
+
 class FRemEditorUtilitiesModule : public IRemEditorUtilitiesModule
 {
+    FDelegateHandle ExpandedPathsMemReportHandle;
+    FDelegateHandle OnPostGarbageCollectHandle;
+
     /** IModuleInterface implementation */
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
@@ -15,11 +30,38 @@ void FRemEditorUtilitiesModule::StartupModule()
 {
     // This code will execute after your module is loaded into memory (but after global variables are initialized, of course.)
     IRemEditorUtilitiesModule::StartupModule();
+
+    const Rem::Editor::FScopedStartupTimer StartupTimer{TEXT("RemEditorUtilities.StartupModule")};
+
+    // subscribe to engine delegates before any cache is made
+    Rem::Editor::FInvalidationBus::Get();
+
+    // start prewarming property layout data when the editor is idle
+    Rem::Editor::FPropertyLayoutCache::Get();
+
+    ExpandedPathsMemReportHandle = Rem::Editor::FMemReport::Get().Register(TEXT("GenerationPass"),
+        Rem::Editor::FMemReportProvider::CreateStatic(&Rem::Editor::FGenerationPass::ReportMemory));
+    OnPostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(
+        &Rem::Editor::FGenerationPass::PruneExpandedPaths);
 }
 
 void FRemEditorUtilitiesModule::ShutdownModule()
 {
     // This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
     // we call this function before unloading the module.
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(OnPostGarbageCollectHandle);
+    Rem::Editor::FMemReport::Unregister(ExpandedPathsMemReportHandle);
+
+    Rem::Editor::FAssetEditorInstanceCache::Shutdown();
+    Rem::Editor::FWidgetNameResolver::Shutdown();
+    Rem::Editor::FPropertyWidgetPool::Shutdown();
+    Rem::Editor::FWidgetTreeIndexService::Shutdown();
+    Rem::Editor::FPropertyLayoutCache::Shutdown();
+    Rem::Editor::FPropertyPathCache::Shutdown();
+
+    // after the caches, they unregister on destruction
+    Rem::Editor::FInvalidationBus::Shutdown();
+    Rem::Editor::FMemReport::Shutdown();
+
     IRemEditorUtilitiesModule::ShutdownModule();
 }
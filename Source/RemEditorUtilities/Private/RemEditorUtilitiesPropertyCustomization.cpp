@@ -0,0 +1,88 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesPropertyCustomization.h"
+
+#include "RemEditorUtilitiesPropertyLayout.h"
+#include "RemEditorUtilitiesPropertyLayoutCache.h"
+#include "UObject/UnrealType.h"
+
+namespace Rem::Editor
+{
+
+uint64 FPropertyCustomizationDescriptor::GetObjectCastFlags() const
+{
+    return PropertyClass ? PropertyClass->GetId() : 0;
+}
+
+bool FPropertyCustomizationDescriptor::IsCustomized(const FProperty* Property) const
+{
+    if (!Property || !PropertyClass || !Property->IsA(PropertyClass))
+    {
+        return false;
+    }
+
+    const auto* ReferencedClass = static_cast<const FObjectPropertyBase*>(Property)->PropertyClass.Get();
+    return ReferencedClass && ReferencedClass->IsChildOf(BaseClass);
+}
+
+bool FPropertyCustomizationDescriptor::IsElementSupported(const FProperty* ElementProperty) const
+{
+    return IsCustomized(ElementProperty) || CastField<FStructProperty>(ElementProperty);
+}
+
+void GenerateWidgetForContainerContent(const TSharedRef<IPropertyHandle>& ContainerHandle,
+    IDetailGroup& ContainerGroup, const FPropertyCustomizationDescriptor& Descriptor,
+    // ReSharper disable once CppPassValueParameterByConstReference
+    const FPropertyCustomizationFunctor Predicate, const Enum::EContainerCombination ContainerType)
+{
+    const FScopedGenerationPass Pass;
+    FPropertyLayoutCache::Get().AddDescriptor(Descriptor);
+
+    FPropertyLayoutModel Model;
+    const int32 Group = Model.AddExternalGroup();
+    BuildContainerContentLayout(Model, Group, ContainerHandle, Model.AddRootHandle(), Descriptor, ContainerType);
+
+    ApplyPropertyLayout(Model, {ContainerHandle}, {&ContainerGroup}, Predicate);
+}
+
+void GenerateWidgetForContainerElement(IDetailGroup& ParentGroup, const TSharedRef<IPropertyHandle>& ElementHandle,
+    const FPropertyCustomizationDescriptor& Descriptor,
+    // ReSharper disable once CppPassValueParameterByConstReference
+    const FPropertyCustomizationFunctor Predicate, const Enum::EContainerCombination ContainerType)
+{
+    const FScopedGenerationPass Pass;
+    FPropertyLayoutCache::Get().AddDescriptor(Descriptor);
+
+    FPropertyLayoutModel Model;
+    const int32 Group = Model.AddExternalGroup();
+    BuildContainerElementLayout(Model, Group, ElementHandle, Model.AddRootHandle(), Descriptor, ContainerType);
+
+    ApplyPropertyLayout(Model, {ElementHandle}, {&ParentGroup}, Predicate);
+}
+
+void GenerateWidgetsForNestedElement(const TSharedRef<IPropertyHandle>& ElementHandle, const uint32 NumChildren,
+    FChildGroupLayerMapping& ChildGroupLayerMapping, const uint32 Layer,
+    const FPropertyCustomizationDescriptor& Descriptor,
+    // ReSharper disable once CppPassValueParameterByConstReference
+    const FPropertyCustomizationFunctor Predicate, const Enum::EContainerCombination ContainerType)
+{
+    const FScopedGenerationPass Pass;
+    FPropertyLayoutCache::Get().AddDescriptor(Descriptor);
+
+    // groups already made by the caller become external nodes of the model
+    FPropertyLayoutModel Model;
+    TScratchArray<IDetailGroup*> ExternalGroups;
+    FLayoutGroupLayerMapping LayoutGroupLayerMapping;
+    AddExternalGroups(Model, ChildGroupLayerMapping, LayoutGroupLayerMapping, ExternalGroups);
+
+    BuildNestedElementLayout(Model, ElementHandle, Model.AddRootHandle(), NumChildren, LayoutGroupLayerMapping, Layer,
+        Descriptor, ContainerType);
+
+    TArray<IDetailGroup*> Groups;
+    ApplyPropertyLayout(Model, {ElementHandle}, ExternalGroups, Predicate, &Groups);
+
+    // hand the category groups made on the way back to the caller
+    CollectLayoutGroups(LayoutGroupLayerMapping, Groups, ChildGroupLayerMapping);
+}
+
+}
@@ -0,0 +1,875 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesPropertyLayout.h"
+
+#include "RemEditorUtilitiesPropertyLayoutCache.h"
+#include "RemEditorUtilitiesPropertyVisitor.h"
+#include "RemEditorUtilitiesStatics.h"
+#include "DetailWidgetRow.h"
+#include "IDetailGroup.h"
+#include "IDetailPropertyRow.h"
+#include "InstancedStructDetails.h"
+#include "Macro/RemAssertionMacros.h"
+#include "ObjectEditorUtils.h"
+#include "PropertyHandle.h"
+#include "Misc/StringBuilder.h"
+#include "String/ParseTokens.h"
+#include "StructUtils/InstancedStruct.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+using namespace Rem;
+using namespace Rem::Editor;
+
+/**
+ * @brief How a nested property ends up in the details panel
+ */
+enum class ENestedPropertyRow : uint8
+{
+    // a default property row
+    Default,
+    // a property row with custom widget made by the predicate
+    Custom,
+    // nodes already added (eg: container group)
+    Generated,
+};
+
+/**
+ * @return concrete type shared by all the instanced structs of the handle, nullptr if none or they differ
+ */
+const UScriptStruct* GetInstancedStructType(const IPropertyHandle& StructHandle)
+{
+    const UScriptStruct* ScriptStruct{};
+    StructHandle.EnumerateConstRawData([&ScriptStruct](const void* RawData, const int32 DataIndex, int32)
+    {
+        const auto* DataType = RawData ? static_cast<const FInstancedStruct*>(RawData)->GetScriptStruct() : nullptr;
+        if (DataIndex == 0)
+        {
+            ScriptStruct = DataType;
+            return true;
+        }
+
+        if (DataType != ScriptStruct)
+        {
+            ScriptStruct = nullptr;
+            return false;
+        }
+
+        return true;
+    });
+
+    return ScriptStruct;
+}
+
+/**
+ * @brief Members are laid out for the type at the time, rebuild the parent once the instanced struct changes its type.
+ * Edits of the members don't rebuild anything
+ */
+void WatchInstancedStructType(const TSharedRef<IPropertyHandle>& StructHandle, const UScriptStruct& ScriptStruct)
+{
+    const TSharedPtr<IPropertyHandle> ParentHandle = StructHandle->GetParentHandle();
+    if (!ParentHandle)
+    {
+        return;
+    }
+
+    StructHandle->SetOnPropertyValueChanged(FSimpleDelegate::CreateLambda(
+        [WeakStructHandle = StructHandle.ToWeakPtr(), WeakParentHandle = ParentHandle.ToWeakPtr(),
+            WeakScriptStruct = TWeakObjectPtr<const UScriptStruct>{&ScriptStruct}]
+        {
+            const auto PinnedStructHandle = WeakStructHandle.Pin();
+            const auto PinnedParentHandle = WeakParentHandle.Pin();
+            if (PinnedStructHandle && PinnedParentHandle
+                && GetInstancedStructType(*PinnedStructHandle) != WeakScriptStruct.Get())
+            {
+                PinnedParentHandle->RequestRebuildChildren();
+            }
+        }));
+}
+
+/**
+ * @brief Lay out the members of an instanced struct into its group.
+ * Members are only reachable through a structure node reading the instance memory, it's added along with the watch
+ * once per property node, and stays until the property node is rebuilt
+ */
+void ApplyInstancedStructLayout(IDetailGroup& StructGroup, const TSharedRef<IPropertyHandle>& StructHandle,
+    const UScriptStruct& ScriptStruct, const FPropertyCustomizationDescriptor& Descriptor,
+    const FPropertyCustomizationFunctor& Predicate)
+{
+    // the type changed since the model is built, the watch bound back then rebuilds the parent
+    if (GetInstancedStructType(*StructHandle) != &ScriptStruct)
+    {
+        return;
+    }
+
+    uint32 NumChildren;
+    StructHandle->GetNumChildren(NumChildren);
+
+    if (NumChildren == 0)
+    {
+        StructHandle->AddChildStructure(MakeShared<FInstancedStructProvider>(StructHandle));
+        StructHandle->GetNumChildren(NumChildren);
+
+        WatchInstancedStructType(StructHandle, ScriptStruct);
+    }
+
+    if (NumChildren == 0)
+    {
+        return;
+    }
+
+    const FScopedGenerationPass Pass;
+
+    FPropertyLayoutModel Model;
+    const int32 Group = Model.AddExternalGroup();
+
+    // member of USTRUCT with no category specified will default to the category of "type name of the USTRUCT",
+    // so we add extra mapping here to redirect it
+    FLayoutGroupLayerMapping ChildGroupLayerMapping;
+    auto& FirstLayer = ChildGroupLayerMapping.Emplace_GetRef();
+    FirstLayer.Add(NAME_None, Group);
+    FirstLayer.Add(ScriptStruct.GetFName(), Group);
+
+    // the structure node has no property, it's traversed like a category
+    BuildNestedElementLayout(Model, StructHandle, Model.AddRootHandle(), NumChildren, ChildGroupLayerMapping, 0,
+        Descriptor, Enum::EContainerCombination::Struct);
+
+    ApplyPropertyLayout(Model, {StructHandle}, {&StructGroup}, Predicate);
+}
+
+/**
+ * @brief Classify a nested property, and add container group for it if needed.
+ * Object properties are classified with the descriptor at runtime, so it's the same code for every customization
+ */
+struct FNestedPropertyVisitor : TPropertyVisitor<FNestedPropertyVisitor, FObjectPropertyBase, ENestedPropertyRow>
+{
+    FPropertyLayoutModel& Model;
+    const TSharedRef<IPropertyHandle>& ChildHandle;
+    const int32 ChildPath;
+    const int32 PropertyGroup;
+    const FPropertyCustomizationDescriptor& Descriptor;
+
+    FNestedPropertyVisitor(FPropertyLayoutModel& InModel, const TSharedRef<IPropertyHandle>& InChildHandle,
+        const int32 InChildPath, const int32 InPropertyGroup, const FPropertyCustomizationDescriptor& InDescriptor)
+        : Model(InModel)
+        , ChildHandle(InChildHandle)
+        , ChildPath(InChildPath)
+        , PropertyGroup(InPropertyGroup)
+        , Descriptor(InDescriptor)
+    {
+    }
+
+    ENestedPropertyRow VisitObject(const FObjectPropertyBase& ObjectPropertyBase) const
+    {
+        return Descriptor.IsCustomized(&ObjectPropertyBase)
+                   ? ENestedPropertyRow::Custom
+                   : ENestedPropertyRow::Default;
+    }
+
+    ENestedPropertyRow VisitArray(const FArrayProperty& ArrayProperty) const
+    {
+        if (!Descriptor.IsElementSupported(ArrayProperty.Inner))
+        {
+            return ENestedPropertyRow::Default;
+        }
+
+        return AddContainer(Enum::EContainerCombination::Array);
+    }
+
+    ENestedPropertyRow VisitMap(const FMapProperty& MapProperty) const
+    {
+        const bool bMapKey   = Descriptor.IsCustomized(MapProperty.KeyProp);
+        const bool bMapValue = Descriptor.IsElementSupported(MapProperty.ValueProp);
+
+        if (bMapKey && bMapValue)
+        {
+            return AddContainer(Enum::EContainerCombination::Map);
+        }
+
+        if (bMapKey)
+        {
+            return AddContainer(Enum::EContainerCombination::MapKey);
+        }
+
+        if (bMapValue)
+        {
+            return AddContainer(Enum::EContainerCombination::MapValue);
+        }
+
+        return ENestedPropertyRow::Default;
+    }
+
+    ENestedPropertyRow VisitSet(const FSetProperty& SetProperty) const
+    {
+        if (!Descriptor.IsElementSupported(SetProperty.ElementProp))
+        {
+            return ENestedPropertyRow::Default;
+        }
+
+        return AddContainer(Enum::EContainerCombination::Set);
+    }
+
+    ENestedPropertyRow VisitStruct(const FStructProperty& StructProperty) const
+    {
+        // TODO this will cause inner properties of customized struct type being shown up redundantly.
+        // eg: FGameplayTag::TagName, we need a way to identify whether a struct type has a detail customization
+        // FPropertyEditorModule::IsCustomizedStruct looks not exposed at the moment
+        return AddContainer(Enum::EContainerCombination::Struct);
+    }
+
+    ENestedPropertyRow VisitInstancedStruct(const FStructProperty& StructProperty) const
+    {
+        // types with nothing to customize keep the default row, along with its own customization
+        const UScriptStruct* ScriptStruct = GetInstancedStructType(*ChildHandle);
+        if (!ScriptStruct || !FPropertyLayoutCache::Get().FindInstancedStructPlan(*ScriptStruct).IsTraversed())
+        {
+            return ENestedPropertyRow::Default;
+        }
+
+        // members are laid out by ApplyPropertyLayout, they are only reachable once a structure node is added, and
+        // building the model never touches the handle tree
+        FPropertyLayoutNode Node;
+        Node.Kind                = EPropertyLayoutNodeKind::Group;
+        Node.Parent              = PropertyGroup;
+        Node.Name                = FObjectEditorUtils::GetCategoryFName(&StructProperty);
+        Node.DisplayName         = FObjectEditorUtils::GetCategoryText(&StructProperty);
+        Node.Property            = &StructProperty;
+        Node.HandlePath          = ChildPath;
+        Node.InstancedStructType = ScriptStruct;
+        Node.Descriptor          = Descriptor;
+
+        Model.AddNode(MoveTemp(Node));
+        return ENestedPropertyRow::Generated;
+    }
+
+    ENestedPropertyRow VisitOther(const FProperty& Property) const
+    {
+        return ENestedPropertyRow::Default;
+    }
+
+private:
+    /**
+     * @brief Model version of GenerateContainerHeader
+     */
+    ENestedPropertyRow AddContainer(const Enum::EContainerCombination ContainerType) const
+    {
+        const FProperty* ContainerProperty = ChildHandle->GetProperty();
+
+        FPropertyLayoutNode Node;
+        Node.Kind           = EPropertyLayoutNodeKind::Group;
+        Node.Parent         = PropertyGroup;
+        Node.Name           = FObjectEditorUtils::GetCategoryFName(ContainerProperty);
+        Node.DisplayName    = FObjectEditorUtils::GetCategoryText(ContainerProperty);
+        Node.Property       = ContainerProperty;
+        Node.HandlePath     = ChildPath;
+
+        const int32 ContainerGroup = Model.AddNode(MoveTemp(Node));
+        BuildContainerContentLayout(Model, ContainerGroup, ChildHandle, ChildPath, Descriptor, ContainerType);
+        return ENestedPropertyRow::Generated;
+    }
+};
+
+/**
+ * @brief Narrow the kind classified with FObjectPropertyBase down to the object property type of the descriptor
+ */
+EPropertyVisitKind GetPropertyVisitKind(const FProperty& Property, const EPropertyVisitKind BaseKind,
+    const uint64 ObjectCastFlags)
+{
+    if (BaseKind != EPropertyVisitKind::Object)
+    {
+        return BaseKind;
+    }
+
+    return static_cast<uint64>(Property.GetClass()->GetCastFlags()) & ObjectCastFlags
+               ? EPropertyVisitKind::Object
+               : EPropertyVisitKind::Other;
+}
+
+void AddExpandRemainingNode(FPropertyLayoutModel& Model, const int32 Group, const IPropertyHandle& PropertyHandle,
+    const int32 HandlePath, const int32 NumRemaining, const EGenerationGuardrail Guardrail)
+{
+    FPropertyLayoutNode Node;
+    Node.Kind         = EPropertyLayoutNodeKind::ExpandRemaining;
+    Node.Parent       = Group;
+    Node.Property     = PropertyHandle.GetProperty();
+    Node.HandlePath   = HandlePath;
+    Node.NumRemaining = NumRemaining;
+    Node.Guardrail    = Guardrail;
+
+    Model.AddNode(MoveTemp(Node));
+}
+}
+
+namespace Rem::Editor
+{
+
+int32 FPropertyLayoutModel::AddExternalGroup()
+{
+    FPropertyLayoutNode Node;
+    Node.Kind          = EPropertyLayoutNodeKind::External;
+    Node.ExternalIndex = NumExternalGroups++;
+
+    return Nodes.Add(MoveTemp(Node));
+}
+
+int32 FPropertyLayoutModel::AddNode(FPropertyLayoutNode&& Node)
+{
+    check(Node.Kind == EPropertyLayoutNodeKind::External || Nodes.IsValidIndex(Node.Parent));
+
+    return Nodes.Add(MoveTemp(Node));
+}
+
+int32 FPropertyLayoutModel::AddRootHandle()
+{
+    return HandlePaths.Add({INDEX_NONE, NumRootHandles++});
+}
+
+int32 FPropertyLayoutModel::AddChildHandle(const int32 ParentPath, const uint32 ChildIndex)
+{
+    check(HandlePaths.IsValidIndex(ParentPath));
+
+    return HandlePaths.Add({ParentPath, static_cast<int32>(ChildIndex)});
+}
+
+void FPropertyLayoutModel::Reset()
+{
+    Nodes.Reset();
+    HandlePaths.Reset();
+    NumExternalGroups = 0;
+    NumRootHandles    = 0;
+}
+
+bool FPropertyLayoutModel::IsSameLayout(const FPropertyLayoutModel& Other) const
+{
+    if (Nodes.Num() != Other.Nodes.Num()
+        || NumExternalGroups != Other.NumExternalGroups
+        || NumRootHandles != Other.NumRootHandles
+        || HandlePaths != Other.HandlePaths)
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+    {
+        const auto& Node      = Nodes[Index];
+        const auto& OtherNode = Other.Nodes[Index];
+
+        if (Node.Kind != OtherNode.Kind
+            || Node.Parent != OtherNode.Parent
+            || Node.Name != OtherNode.Name
+            || Node.ExternalIndex != OtherNode.ExternalIndex
+            || Node.Property != OtherNode.Property
+            || Node.HandlePath != OtherNode.HandlePath
+            || Node.ContainerType != OtherNode.ContainerType
+            || Node.bCustomized != OtherNode.bCustomized
+            || Node.InstancedStructType != OtherNode.InstancedStructType
+            || Node.Descriptor.PropertyClass != OtherNode.Descriptor.PropertyClass
+            || Node.Descriptor.BaseClass != OtherNode.Descriptor.BaseClass
+            || Node.NumRemaining != OtherNode.NumRemaining
+            || Node.Guardrail != OtherNode.Guardrail)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32 FPropertyLayoutModel::GetLayoutHash() const
+{
+    uint32 Hash = HashCombineFast(::GetTypeHash(NumExternalGroups), ::GetTypeHash(NumRootHandles));
+
+    for (const auto& [Parent, ChildIndex] : HandlePaths)
+    {
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Parent));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(ChildIndex));
+    }
+
+    for (const auto& Node : Nodes)
+    {
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Node.Kind));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Node.Parent));
+        Hash = HashCombineFast(Hash, GetTypeHash(Node.Name));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Node.ExternalIndex));
+        Hash = HashCombineFast(Hash, PointerHash(Node.Property));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Node.HandlePath));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Node.ContainerType));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Node.bCustomized));
+        Hash = HashCombineFast(Hash, PointerHash(Node.InstancedStructType.Get()));
+        Hash = HashCombineFast(Hash, PointerHash(Node.Descriptor.PropertyClass));
+        Hash = HashCombineFast(Hash, PointerHash(Node.Descriptor.BaseClass));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Node.NumRemaining));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Node.Guardrail));
+    }
+
+    return Hash;
+}
+
+int32 MakePropertyLayoutGroups(FPropertyLayoutModel& Model, FLayoutGroupLayerMapping& ChildGroupLayerMapping,
+    const FName PropertyGroupName)
+{
+    checkf(FGenerationPass::GetCurrent(), TEXT("FLayoutGroupLayerMapping is only valid inside a generation pass"));
+
+    if (PropertyGroupName == NAME_None)
+    {
+        // no group property only show up at first layer
+        return ChildGroupLayerMapping[0][NAME_None];
+    }
+
+    TStringBuilder<256> PropertyGroupString;
+    PropertyGroupName.AppendString(PropertyGroupString);
+
+    // remove space from start and end, ensuring category is properly retrieved
+    TScratchArray<FName> CategoryPath;
+    UE::String::ParseTokens(PropertyGroupString, TEXT('|'),
+        [&CategoryPath](const FStringView CurrentCategoryString)
+        {
+            CategoryPath.Emplace(CurrentCategoryString.Len(), CurrentCategoryString.GetData());
+        }, UE::String::EParseTokensOptions::SkipEmpty | UE::String::EParseTokensOptions::Trim);
+
+    return MakePropertyLayoutGroups(Model, ChildGroupLayerMapping, CategoryPath);
+}
+
+int32 MakePropertyLayoutGroups(FPropertyLayoutModel& Model, FLayoutGroupLayerMapping& ChildGroupLayerMapping,
+    const TConstArrayView<FName> CategoryPath)
+{
+    checkf(FGenerationPass::GetCurrent(), TEXT("FLayoutGroupLayerMapping is only valid inside a generation pass"));
+
+    int32 PropertyGroup = INDEX_NONE;
+
+    // build the group hierarchy from top(left) to bottom(right)
+    int32 LastGroup = INDEX_NONE;
+
+    for (int32 CategoryLayer = 0; CategoryLayer < CategoryPath.Num(); ++CategoryLayer)
+    {
+        // make sure size is big enough
+        if (ChildGroupLayerMapping.Num() <= CategoryLayer)
+        {
+            ChildGroupLayerMapping.AddDefaulted(CategoryLayer + 1 - ChildGroupLayerMapping.Num());
+        }
+
+        const FName CurrentCategoryName = CategoryPath[CategoryLayer];
+
+        if (const int32* ExistingGroup = ChildGroupLayerMapping[CategoryLayer].Find(CurrentCategoryName))
+        {
+            PropertyGroup = *ExistingGroup;
+        }
+        else
+        {
+            FPropertyLayoutNode Node;
+            Node.Kind        = EPropertyLayoutNodeKind::Group;
+            Node.Parent      = CategoryLayer == 0 ? ChildGroupLayerMapping[0][NAME_None] : LastGroup;
+            Node.Name        = CurrentCategoryName;
+            Node.DisplayName = FText::FromName(CurrentCategoryName);
+
+            PropertyGroup = Model.AddNode(MoveTemp(Node));
+            ChildGroupLayerMapping[CategoryLayer].Add(CurrentCategoryName, PropertyGroup);
+        }
+
+        LastGroup = PropertyGroup;
+    }
+
+    return PropertyGroup;
+}
+
+void AddExternalGroups(FPropertyLayoutModel& Model, const FChildGroupLayerMapping& ChildGroupLayerMapping,
+    FLayoutGroupLayerMapping& OutLayoutGroupLayerMapping, TScratchArray<IDetailGroup*>& OutExternalGroups)
+{
+    checkf(FGenerationPass::GetCurrent(), TEXT("FLayoutGroupLayerMapping is only valid inside a generation pass"));
+
+    OutLayoutGroupLayerMapping.SetNum(ChildGroupLayerMapping.Num());
+
+    for (int32 LayerIndex = 0; LayerIndex < ChildGroupLayerMapping.Num(); ++LayerIndex)
+    {
+        for (const auto& [GroupName, DetailGroup] : ChildGroupLayerMapping[LayerIndex])
+        {
+            OutLayoutGroupLayerMapping[LayerIndex].Add(GroupName, Model.AddExternalGroup());
+            OutExternalGroups.Add(DetailGroup);
+        }
+    }
+}
+
+void CollectLayoutGroups(const FLayoutGroupLayerMapping& LayoutGroupLayerMapping,
+    const TConstArrayView<IDetailGroup*> Groups, FChildGroupLayerMapping& ChildGroupLayerMapping)
+{
+    ChildGroupLayerMapping.SetNum(LayoutGroupLayerMapping.Num());
+
+    for (int32 LayerIndex = 0; LayerIndex < LayoutGroupLayerMapping.Num(); ++LayerIndex)
+    {
+        for (const auto& [GroupName, Node] : LayoutGroupLayerMapping[LayerIndex])
+        {
+            if (!ChildGroupLayerMapping[LayerIndex].Contains(GroupName) && Groups[Node])
+            {
+                ChildGroupLayerMapping[LayerIndex].Add(GroupName, Groups[Node]);
+            }
+        }
+    }
+}
+
+void BuildContainerContentLayout(FPropertyLayoutModel& Model, const int32 ContainerGroup,
+    const TSharedRef<IPropertyHandle>& ContainerHandle, const int32 ContainerPath,
+    const FPropertyCustomizationDescriptor& Descriptor, const Enum::EContainerCombination ContainerType)
+{
+    const FScopedGenerationPass Pass;
+
+    uint32 NumChildren;
+    ContainerHandle->GetNumChildren(NumChildren);
+
+    const FScopedGenerationDepth DepthScope(*Pass, ContainerHandle);
+    if (Pass->IsDepthExceeded())
+    {
+        AddExpandRemainingNode(Model, ContainerGroup, *ContainerHandle, ContainerPath, NumChildren,
+            EGenerationGuardrail::Depth);
+        return;
+    }
+
+    if (ContainerType != Enum::EContainerCombination::Struct)
+    {
+        // traverse the container
+        for (uint32 Index = 0; Index < NumChildren; ++Index)
+        {
+            if (Pass->IsRowsExceeded())
+            {
+                AddExpandRemainingNode(Model, ContainerGroup, *ContainerHandle, ContainerPath, NumChildren - Index,
+                    EGenerationGuardrail::Rows);
+                break;
+            }
+
+            const TSharedPtr<IPropertyHandle> ElementHandle = ContainerHandle->GetChildHandle(Index);
+            RemCheckCondition(ElementHandle.IsValid(), continue;);
+
+            BuildContainerElementLayout(Model, ContainerGroup, ElementHandle.ToSharedRef(),
+                Model.AddChildHandle(ContainerPath, Index), Descriptor, ContainerType);
+        }
+    }
+    else
+    {
+        const FName StructTypeName = CastFieldChecked<FStructProperty>(ContainerHandle->GetProperty())->Struct->
+            GetFName();
+
+        // member of USTRUCT with no category specified will default to the category of "type name of the USTRUCT",
+        // so we add extra mapping here to redirect it
+        FLayoutGroupLayerMapping ChildGroupLayerMapping;
+        auto& FirstLayer = ChildGroupLayerMapping.Emplace_GetRef();
+        FirstLayer.Add(NAME_None, ContainerGroup);
+        FirstLayer.Add(StructTypeName, ContainerGroup);
+
+        BuildNestedElementLayout(Model, ContainerHandle, ContainerPath, NumChildren, ChildGroupLayerMapping, 0,
+            Descriptor, ContainerType);
+    }
+}
+
+void BuildContainerElementLayout(FPropertyLayoutModel& Model, const int32 ParentGroup,
+    const TSharedRef<IPropertyHandle>& ElementHandle, const int32 ElementPath,
+    const FPropertyCustomizationDescriptor& Descriptor, const Enum::EContainerCombination ContainerType)
+{
+    const FScopedGenerationPass Pass;
+    Pass->AddRow();
+
+    const auto* StructProperty = CastField<FStructProperty>(ElementHandle->GetProperty());
+
+    // add index[] group
+    FPropertyLayoutNode ElementNode;
+    ElementNode.Kind           = EPropertyLayoutNodeKind::Group;
+    ElementNode.Parent         = ParentGroup;
+    ElementNode.Name           = MakeIndexGroupName(ElementHandle->GetIndexInArray());
+    ElementNode.DisplayName    = FText::FromName(ElementNode.Name);
+    ElementNode.Property       = ElementHandle->GetProperty();
+    ElementNode.HandlePath     = ElementPath;
+    ElementNode.ContainerType  = ContainerType;
+
+    // TMap / TSet / TArray element gets its widget from the predicate
+    ElementNode.bCustomized = ContainerType != Enum::EContainerCombination::ContainerItself && !StructProperty;
+
+    const bool bCustomized   = ElementNode.bCustomized;
+    const int32 ElementGroup = Model.AddNode(MoveTemp(ElementNode));
+    if (bCustomized)
+    {
+        return;
+    }
+
+    // add element properties and groups
+
+    if (!IsContainerElementValid(ElementHandle))
+    {
+        // invalid element that don't have any children
+        return;
+    }
+
+    const auto ElementValueHandle = StructProperty
+                                        ? ElementHandle
+                                        : ElementHandle->GetChildHandle(0).ToSharedRef();
+    const int32 ElementValuePath = StructProperty ? ElementPath : Model.AddChildHandle(ElementPath, 0);
+    uint32 NumChildren;
+    ElementValueHandle->GetNumChildren(NumChildren);
+
+    if (NumChildren <= 0)
+    {
+        return;
+    }
+
+    FLayoutGroupLayerMapping ChildGroupLayerMapping;
+    auto& FirstLayer = ChildGroupLayerMapping.Emplace_GetRef();
+    FirstLayer.Add(NAME_None, ElementGroup);
+
+    if (StructProperty)
+    {
+        // member of USTRUCT with no category specified will default to the category of "type name of the USTRUCT",
+        // so we add extra mapping here to redirect it
+        FirstLayer.Add(StructProperty->Struct->GetFName(), ElementGroup);
+    }
+
+    BuildNestedElementLayout(Model, ElementValueHandle, ElementValuePath, NumChildren, ChildGroupLayerMapping, 0,
+        Descriptor, ContainerType);
+}
+
+void BuildNestedElementLayout(FPropertyLayoutModel& Model, const TSharedRef<IPropertyHandle>& ElementHandle,
+    const int32 ElementPath, const uint32 NumChildren, FLayoutGroupLayerMapping& ChildGroupLayerMapping,
+    const uint32 Layer, const FPropertyCustomizationDescriptor& Descriptor,
+    const Enum::EContainerCombination ContainerType)
+{
+    checkf(FGenerationPass::GetCurrent(), TEXT("FLayoutGroupLayerMapping is only valid inside a generation pass"));
+
+    const FScopedGenerationPass Pass;
+    const FScopedGenerationDepth GuardrailScope(*Pass, ElementHandle, 0);
+
+    const uint64 ObjectCastFlags = Descriptor.GetObjectCastFlags();
+    auto& LayoutCache            = FPropertyLayoutCache::Get();
+
+    for (uint32 Index = 0; Index < NumChildren; ++Index)
+    {
+        if (Pass->IsRowsExceeded())
+        {
+            AddExpandRemainingNode(Model, ChildGroupLayerMapping[0][NAME_None], *ElementHandle, ElementPath,
+                NumChildren - Index, EGenerationGuardrail::Rows);
+            break;
+        }
+
+        TSharedPtr<IPropertyHandle> ChildHandlePtr = ElementHandle->GetChildHandle(Index);
+        RemCheckCondition(ChildHandlePtr.IsValid(), continue;);
+
+        auto ChildHandle      = ChildHandlePtr.ToSharedRef();
+        const int32 ChildPath = Model.AddChildHandle(ElementPath, Index);
+
+        // if this child is a property
+        if (const auto* Property = ChildHandle->GetProperty())
+        {
+            // category and kind are usually prewarmed, @see FPropertyLayoutCache
+            const FPropertyLayoutData* LayoutData = LayoutCache.Find(*Property);
+
+            int32 PropertyGroup;
+            EPropertyVisitKind Kind;
+            if (LayoutData)
+            {
+                PropertyGroup = LayoutData->CategoryName.IsNone()
+                                    ? ChildGroupLayerMapping[0][NAME_None]
+                                    : MakePropertyLayoutGroups(Model, ChildGroupLayerMapping,
+                                        LayoutData->CategoryPath);
+                Kind = GetPropertyVisitKind(*Property, LayoutData->Kind, ObjectCastFlags);
+            }
+            else
+            {
+                PropertyGroup = MakePropertyLayoutGroups(Model, ChildGroupLayerMapping,
+                    FObjectEditorUtils::GetCategoryFName(Property));
+                Kind = ClassifyProperty(*Property, ObjectCastFlags);
+            }
+
+            // PropertyGroup need to be valid from now on
+            RemCheckCondition(PropertyGroup != INDEX_NONE, continue;);
+
+            Pass->AddRow();
+
+            FNestedPropertyVisitor Visitor{Model, ChildHandle, ChildPath, PropertyGroup, Descriptor};
+            const ENestedPropertyRow PropertyRow = VisitProperty(*Property, Visitor, Kind);
+            if (PropertyRow == ENestedPropertyRow::Generated)
+            {
+                continue;
+            }
+
+            // add property row
+            FPropertyLayoutNode RowNode;
+            RowNode.Kind           = EPropertyLayoutNodeKind::PropertyRow;
+            RowNode.Parent         = PropertyGroup;
+            RowNode.Property       = Property;
+            RowNode.HandlePath     = ChildPath;
+            RowNode.ContainerType  = ContainerType;
+            RowNode.bCustomized    = PropertyRow == ENestedPropertyRow::Custom;
+
+            Model.AddNode(MoveTemp(RowNode));
+        }
+        // if this child is a category
+        else
+        {
+            // prevent duplicate adding on same layer but different category
+            if (ChildGroupLayerMapping.Num() <= static_cast<int32>(Layer + 1))
+            {
+                ChildGroupLayerMapping.AddDefaulted();
+            }
+
+            uint32 NumChildrenOfChildHandle;
+            ChildHandle->GetNumChildren(NumChildrenOfChildHandle);
+            if (NumChildrenOfChildHandle != 0)
+            {
+                // generate property group and nested property widgets
+                BuildNestedElementLayout(Model, ChildHandle, ChildPath, NumChildrenOfChildHandle,
+                    ChildGroupLayerMapping, Layer + 1, Descriptor, ContainerType);
+            }
+        }
+    }
+}
+
+void ApplyPropertyLayout(const FPropertyLayoutModel& Model,
+    const TConstArrayView<TSharedRef<IPropertyHandle>> RootHandles, const TConstArrayView<IDetailGroup*> ExternalGroups,
+    // ReSharper disable once CppPassValueParameterByConstReference
+    const FPropertyCustomizationFunctor Predicate, TArray<IDetailGroup*>* OutGroups)
+{
+    RemCheckCondition(ExternalGroups.Num() == Model.NumExternalGroups, return;);
+    RemCheckCondition(RootHandles.Num() == Model.NumRootHandles, return;);
+
+    // bind the handles of all paths in one pass, parents precede their children
+    TArray<TSharedPtr<IPropertyHandle>, TInlineAllocator<64>> Handles;
+    Handles.SetNum(Model.HandlePaths.Num());
+
+    for (int32 Index = 0; Index < Model.HandlePaths.Num(); ++Index)
+    {
+        const auto& [Parent, ChildIndex] = Model.HandlePaths[Index];
+        if (Parent == INDEX_NONE)
+        {
+            Handles[Index] = RootHandles[ChildIndex];
+        }
+        else if (const auto& ParentHandle = Handles[Parent])
+        {
+            Handles[Index] = ParentHandle->GetChildHandle(ChildIndex);
+        }
+    }
+
+    // detail group of each group node, null for rows
+    TArray<IDetailGroup*, TInlineAllocator<64>> Groups;
+    Groups.SetNumZeroed(Model.Nodes.Num());
+
+    for (int32 Index = 0; Index < Model.Nodes.Num(); ++Index)
+    {
+        const auto& Node = Model.Nodes[Index];
+
+        if (Node.Kind == EPropertyLayoutNodeKind::External)
+        {
+            Groups[Index] = ExternalGroups[Node.ExternalIndex];
+            continue;
+        }
+
+        // the parent is skipped
+        IDetailGroup* ParentGroup = Groups[Node.Parent];
+        if (!ParentGroup)
+        {
+            continue;
+        }
+
+        TSharedPtr<IPropertyHandle> PropertyHandle;
+        if (Node.HandlePath != INDEX_NONE)
+        {
+            // the handle tree changed since the model is built
+            PropertyHandle = Handles[Node.HandlePath];
+            if (!PropertyHandle || PropertyHandle->GetProperty() != Node.Property)
+            {
+                continue;
+            }
+        }
+
+        switch (Node.Kind)
+        {
+        case EPropertyLayoutNodeKind::Group:
+            {
+                IDetailGroup& Group = ParentGroup->AddGroup(Node.Name, Node.DisplayName);
+                Groups[Index]       = &Group;
+
+                if (!PropertyHandle)
+                {
+                    break;
+                }
+
+                IDetailPropertyRow& HeaderRow = Group.HeaderProperty(PropertyHandle.ToSharedRef());
+                if (Node.bCustomized)
+                {
+                    Predicate(PropertyHandle.ToSharedRef(), HeaderRow.CustomWidget(), Node.ContainerType);
+                }
+
+                if (const UScriptStruct* ScriptStruct = Node.InstancedStructType.Get())
+                {
+                    ApplyInstancedStructLayout(Group, PropertyHandle.ToSharedRef(), *ScriptStruct, Node.Descriptor,
+                        Predicate);
+                }
+                break;
+            }
+        case EPropertyLayoutNodeKind::PropertyRow:
+            {
+                RemCheckVariable(PropertyHandle, break;);
+
+                IDetailPropertyRow& WidgetPropertyRow = ParentGroup->AddPropertyRow(PropertyHandle.ToSharedRef());
+                WidgetPropertyRow.EditCondition(PropertyHandle->IsEditable(), {});
+
+                if (Node.bCustomized)
+                {
+                    Predicate(PropertyHandle.ToSharedRef(), WidgetPropertyRow.CustomWidget(), Node.ContainerType);
+                }
+                break;
+            }
+        case EPropertyLayoutNodeKind::ExpandRemaining:
+            {
+                RemCheckVariable(PropertyHandle, break;);
+
+                AddExpandRemainingRow(*ParentGroup, PropertyHandle.ToSharedRef(), Node.NumRemaining, Node.Guardrail);
+                break;
+            }
+        default:
+            break;
+        }
+    }
+
+    if (OutGroups)
+    {
+        OutGroups->Reset(Groups.Num());
+        OutGroups->Append(Groups);
+    }
+}
+FSimpleDelegate MakeContainerLayoutRefresh(const TSharedRef<IPropertyHandle>& ContainerHandle,
+    const FPropertyCustomizationDescriptor& Descriptor, const Enum::EContainerCombination ContainerType,
+    FSimpleDelegate Refresh)
+{
+    auto BuildLayout = [Descriptor, ContainerType](FPropertyLayoutModel& Model,
+        const TSharedRef<IPropertyHandle>& Handle)
+    {
+        const FScopedGenerationPass Pass;
+
+        const int32 Group = Model.AddExternalGroup();
+        BuildContainerContentLayout(Model, Group, Handle, Model.AddRootHandle(), Descriptor, ContainerType);
+    };
+
+    // the layout applied along with this callback
+    const auto AppliedModel = MakeShared<FPropertyLayoutModel>();
+    BuildLayout(*AppliedModel, ContainerHandle);
+
+    return FSimpleDelegate::CreateLambda(
+        [WeakContainerHandle = ContainerHandle.ToWeakPtr(), BuildLayout, AppliedModel,
+            AppliedHash = AppliedModel->GetLayoutHash(), Refresh = MoveTemp(Refresh)]
+        {
+            const auto PinnedContainerHandle = WeakContainerHandle.Pin();
+            if (!PinnedContainerHandle)
+            {
+                return;
+            }
+
+            FPropertyLayoutModel Model;
+            BuildLayout(Model, PinnedContainerHandle.ToSharedRef());
+
+            // the rows already there are bound to the same handles, nothing to apply
+            if (Model.GetLayoutHash() == AppliedHash && Model.IsSameLayout(*AppliedModel))
+            {
+                return;
+            }
+
+            Refresh.ExecuteIfBound();
+        });
+}
+
+}
@@ -0,0 +1,540 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesPropertyLayoutCache.h"
+
+#include "ObjectEditorUtils.h"
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesLog.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesStat.h"
+#include "Async/ParallelFor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet2/StructureEditorUtils.h"
+#include "Misc/StringBuilder.h"
+#include "String/ParseTokens.h"
+#include "UObject/GCScopeLock.h"
+#include "UObject/UObjectArray.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Layout Data Structs Prewarmed"), STAT_RemLayoutDataStructsPrewarmed,
+    STATGROUP_RemEditorUtilities);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Layout Data Structs Made On Demand"), STAT_RemLayoutDataStructsOnDemand,
+    STATGROUP_RemEditorUtilities);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Instanced Struct Layout Plans Made"), STAT_RemInstancedStructPlansMade,
+    STATGROUP_RemEditorUtilities);
+
+namespace
+{
+TAutoConsoleVariable CVarLayoutPrewarmEnabled(TEXT("Rem.Editor.LayoutPrewarm.Enabled"), true,
+    TEXT("Prewarm property layout data of loaded native types on worker threads while the editor is idle"));
+
+TAutoConsoleVariable CVarLayoutPrewarmBatchSize(TEXT("Rem.Editor.LayoutPrewarm.BatchSize"), 256,
+    TEXT("Number of types prewarmed per batch, only one batch is in flight at a time"));
+
+TAutoConsoleVariable CVarLayoutPrewarmGatherBudget(TEXT("Rem.Editor.LayoutPrewarm.GatherBudgetMs"), 1.0f,
+    TEXT("Time budget per frame of gathering loaded types to prewarm"));
+
+/** objects visited between checks of the gathering time budget */
+constexpr int32 GatherTimeCheckInterval = 1024;
+
+TAutoConsoleVariable CVarLayoutPrewarmMaxStructs(TEXT("Rem.Editor.LayoutPrewarm.MaxStructs"), 4096,
+    TEXT("Stop prewarming once this many structs have layout data, non-positive means no limit"));
+
+TAutoConsoleVariable CVarLayoutPrewarmIdleSeconds(TEXT("Rem.Editor.LayoutPrewarm.IdleSeconds"), 2.0f,
+    TEXT("Seconds without user interaction before prewarming property layout data"));
+
+bool IsEditorIdle()
+{
+    if (!FSlateApplication::IsInitialized())
+    {
+        return false;
+    }
+
+    const auto& SlateApplication = FSlateApplication::Get();
+    return SlateApplication.GetCurrentTime() - SlateApplication.GetLastUserInteractionTime()
+           >= CVarLayoutPrewarmIdleSeconds.GetValueOnGameThread();
+}
+
+/**
+ * @brief Native types only, reflection of blueprint types could be changed by compiling while a batch is in flight
+ */
+bool IsNativeType(const UStruct& Struct)
+{
+    if (const auto* Class = Cast<UClass>(&Struct))
+    {
+        return Class->HasAnyClassFlags(CLASS_Native);
+    }
+
+    if (const auto* ScriptStruct = Cast<UScriptStruct>(&Struct))
+    {
+        return (ScriptStruct->StructFlags & STRUCT_Native) != 0;
+    }
+
+    return false;
+}
+}
+
+namespace Rem::Editor
+{
+
+bool FInstancedStructLayoutPlan::IsUpToDate(const UScriptStruct& ScriptStruct) const
+{
+    return ChildProperties == ScriptStruct.ChildProperties && PropertiesSize == ScriptStruct.GetPropertiesSize();
+}
+
+/**
+ * @brief Registered to the struct editor manager on construction, FInvalidationBus knows nothing of struct edits
+ */
+struct FPropertyLayoutCache::FStructChangeListener final : FStructureEditorUtils::INotifyOnStructChanged
+{
+    FPropertyLayoutCache& Cache;
+
+    explicit FStructChangeListener(FPropertyLayoutCache& InCache)
+        : Cache(InCache)
+    {
+    }
+
+    virtual void PreChange(const UUserDefinedStruct* Changed,
+        FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override
+    {
+    }
+
+    virtual void PostChange(const UUserDefinedStruct* Changed,
+        FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override
+    {
+        if (Changed)
+        {
+            Cache.DropStruct(*Changed);
+        }
+    }
+};
+
+FPropertyLayoutCache::FPropertyLayoutCache()
+{
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this,
+        &FPropertyLayoutCache::Tick));
+
+    StructChangeListener = MakeUnique<FStructChangeListener>(*this);
+
+    RegisterInvalidation(TEXT("PropertyLayoutCache"),
+        EInvalidationReason::ReflectionChanged | EInvalidationReason::ModulesChanged,
+        FOnInvalidated::CreateLambda([this](const EInvalidationReason Reasons)
+        {
+            if (EnumHasAnyFlags(Reasons, EInvalidationReason::ReflectionChanged))
+            {
+                Reset();
+                return;
+            }
+
+            // prewarmed types stay valid, only the new ones are missing
+            RestartGathering();
+        }));
+
+    RegisterMemReport(TEXT("PropertyLayoutCache"), FMemReportProvider::CreateLambda(
+        [this](TArray<FMemReportEntry>& OutEntries)
+        {
+            int64 NumProperties{};
+            SIZE_T Bytes{StructLayouts.GetAllocatedSize()};
+
+            for (const auto& [Struct, StructLayoutData] : StructLayouts)
+            {
+                NumProperties += StructLayoutData.Num();
+                Bytes += StructLayoutData.GetAllocatedSize();
+
+                for (const auto& [Property, LayoutData] : StructLayoutData)
+                {
+                    Bytes += LayoutData.CategoryPath.GetAllocatedSize();
+                }
+            }
+
+            OutEntries.Add({TEXT("Structs"), StructLayouts.Num(), Bytes});
+            OutEntries.Add({TEXT("Properties"), NumProperties, 0});
+            OutEntries.Add({TEXT("InstancedStructPlans"), InstancedStructPlans.Num(),
+                InstancedStructPlans.GetAllocatedSize()});
+            OutEntries.Add({TEXT("PendingStructs"), PendingStructs.Num(), PendingStructs.GetAllocatedSize()});
+            OutEntries.Add({TEXT("Descriptors"), Descriptors.Num(), Descriptors.GetAllocatedSize()});
+        }));
+}
+
+FPropertyLayoutCache::~FPropertyLayoutCache()
+{
+    CancelPrewarm();
+
+    StructChangeListener.Reset();
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+}
+
+const FPropertyLayoutData* FPropertyLayoutCache::Find(const FProperty& Property)
+{
+    const UStruct* OwnerStruct = Property.GetOwnerStruct();
+    if (!OwnerStruct)
+    {
+        return nullptr;
+    }
+
+    auto IsUpToDate = [&Property](const FPropertyLayoutData& LayoutData)
+    {
+        // a kind of another property type would make the visitor cast to the wrong type
+        return LayoutData.FieldClass == Property.GetClass() && LayoutData.PropertyName == Property.GetFName();
+    };
+
+    auto* StructLayoutData = StructLayouts.Find(OwnerStruct);
+    if (StructLayoutData)
+    {
+        const auto* LayoutData = StructLayoutData->Find(&Property);
+        if (LayoutData && IsUpToDate(*LayoutData))
+        {
+            return LayoutData;
+        }
+    }
+
+    // not made yet, or the owner struct is recompiled and its property addresses are reused
+    INC_DWORD_STAT(STAT_RemLayoutDataStructsOnDemand);
+    LLM_SCOPE_BYTAG(RemEditorUtilities);
+
+    StructLayoutData = &StructLayouts.Add(OwnerStruct, MakeStructLayoutData(*OwnerStruct));
+
+    const auto* LayoutData = StructLayoutData->Find(&Property);
+    return LayoutData && IsUpToDate(*LayoutData) ? LayoutData : nullptr;
+}
+
+const FInstancedStructLayoutPlan& FPropertyLayoutCache::FindInstancedStructPlan(const UScriptStruct& ScriptStruct)
+{
+    if (const auto* Plan = InstancedStructPlans.Find(&ScriptStruct))
+    {
+        if (Plan->IsUpToDate(ScriptStruct))
+        {
+            return *Plan;
+        }
+
+        // recompiled without anyone telling, its layout data is as old as the plan
+        DropStruct(ScriptStruct);
+    }
+
+    INC_DWORD_STAT(STAT_RemInstancedStructPlansMade);
+    LLM_SCOPE_BYTAG(RemEditorUtilities);
+
+    FInstancedStructLayoutPlan Plan;
+    Plan.ChildProperties = ScriptStruct.ChildProperties;
+    Plan.PropertiesSize  = ScriptStruct.GetPropertiesSize();
+
+    for (const UStruct* Struct = &ScriptStruct; Struct; Struct = Struct->GetSuperStruct())
+    {
+        auto* StructLayoutData = StructLayouts.Find(Struct);
+        if (!StructLayoutData)
+        {
+            INC_DWORD_STAT(STAT_RemLayoutDataStructsOnDemand);
+
+            StructLayoutData = &StructLayouts.Add(Struct, MakeStructLayoutData(*Struct));
+        }
+
+        // never dereference the property keys, they could be gone along with a recompiled struct
+        for (const auto& [Property, LayoutData] : *StructLayoutData)
+        {
+            if (LayoutData.Kind != EPropertyVisitKind::Other && LayoutData.bEditable)
+            {
+                ++Plan.NumTraversedMembers;
+            }
+        }
+    }
+
+    return InstancedStructPlans.Add(&ScriptStruct, Plan);
+}
+
+void FPropertyLayoutCache::DropStruct(const UStruct& Struct)
+{
+    StructLayouts.Remove(&Struct);
+
+    for (auto It = InstancedStructPlans.CreateIterator(); It; ++It)
+    {
+        const UScriptStruct* PlanStruct = It.Key().ResolveObjectPtr();
+        if (!PlanStruct || PlanStruct->IsChildOf(&Struct))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FPropertyLayoutCache::AddDescriptor(const FPropertyCustomizationDescriptor& Descriptor)
+{
+    const bool bKnown = Descriptors.ContainsByPredicate([&Descriptor](const FPropertyCustomizationDescriptor& Known)
+    {
+        return Known.PropertyClass == Descriptor.PropertyClass && Known.BaseClass == Descriptor.BaseClass;
+    });
+
+    if (bKnown || !Descriptor.PropertyClass || !Descriptor.BaseClass)
+    {
+        return;
+    }
+
+    Descriptors.Add(Descriptor);
+    RestartGathering();
+}
+
+void FPropertyLayoutCache::CancelPrewarm()
+{
+    if (!InFlightBatch)
+    {
+        return;
+    }
+
+    InFlightBatch->bCancelRequested = true;
+    InFlightTask.Wait();
+
+    InFlightBatch.Reset();
+    InFlightTask = {};
+}
+
+void FPropertyLayoutCache::Reset()
+{
+    CancelPrewarm();
+
+    StructLayouts.Reset();
+    InstancedStructPlans.Reset();
+    PendingStructs.Reset();
+    GatherObjectIndex       = 0;
+    bPendingStructsGathered = false;
+}
+
+FPropertyLayoutCache::FStructLayoutData FPropertyLayoutCache::MakeStructLayoutData(const UStruct& Struct)
+{
+    FStructLayoutData StructLayoutData;
+
+    for (TFieldIterator<FProperty> It(&Struct, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+    {
+        const FProperty* Property = *It;
+
+        FPropertyLayoutData LayoutData;
+        LayoutData.FieldClass   = Property->GetClass();
+        LayoutData.PropertyName = Property->GetFName();
+        LayoutData.bEditable    = Property->HasAnyPropertyFlags(CPF_Edit);
+        LayoutData.CategoryName = FObjectEditorUtils::GetCategoryFName(Property);
+        LayoutData.Kind         = ClassifyProperty<FObjectPropertyBase>(*Property);
+
+        if (!LayoutData.CategoryName.IsNone())
+        {
+            TStringBuilder<256> CategoryString;
+            LayoutData.CategoryName.AppendString(CategoryString);
+
+            UE::String::ParseTokens(CategoryString, TEXT('|'),
+                [&LayoutData](const FStringView Token)
+                {
+                    LayoutData.CategoryPath.Emplace(Token.Len(), Token.GetData());
+                }, UE::String::EParseTokensOptions::SkipEmpty | UE::String::EParseTokensOptions::Trim);
+        }
+
+        StructLayoutData.Add(Property, MoveTemp(LayoutData));
+    }
+
+    return StructLayoutData;
+}
+
+bool FPropertyLayoutCache::Tick(float DeltaTime)
+{
+    if (InFlightBatch)
+    {
+        if (!InFlightTask.IsCompleted())
+        {
+            // never compete with interactive work, the rest of the batch is picked up again later
+            if (!IsEditorIdle())
+            {
+                InFlightBatch->bCancelRequested = true;
+            }
+
+            return true;
+        }
+
+        PublishBatch();
+    }
+
+    if (!CVarLayoutPrewarmEnabled.GetValueOnGameThread() || !IsEditorIdle())
+    {
+        return true;
+    }
+
+    if (Descriptors.IsEmpty() || IsCapacityReached())
+    {
+        return true;
+    }
+
+    if (!bPendingStructsGathered && !GatherPendingStructs())
+    {
+        return true;
+    }
+
+    if (!PendingStructs.IsEmpty())
+    {
+        LaunchBatch();
+    }
+
+    return true;
+}
+
+bool FPropertyLayoutCache::GatherPendingStructs()
+{
+    // walk the object array by index, so it could be resumed next frame, unlike TObjectIterator
+    const double EndTime   = FPlatformTime::Seconds() + CVarLayoutPrewarmGatherBudget.GetValueOnGameThread() / 1000.0;
+    const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+
+    for (; GatherObjectIndex < NumObjects; ++GatherObjectIndex)
+    {
+        if (GatherObjectIndex % GatherTimeCheckInterval == 0 && FPlatformTime::Seconds() >= EndTime)
+        {
+            return false;
+        }
+
+        const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(GatherObjectIndex);
+        if (!ObjectItem || ObjectItem->IsUnreachable() || ObjectItem->HasAnyFlags(EInternalObjectFlags::Garbage))
+        {
+            continue;
+        }
+
+        const auto* Struct = Cast<UStruct>(static_cast<UObject*>(ObjectItem->GetObject()));
+        if (!Struct || Struct->IsA<UFunction>() || !IsNativeType(*Struct) || StructLayouts.Contains(Struct)
+            || !HasCustomizedProperties(*Struct))
+        {
+            continue;
+        }
+
+        PendingStructs.Emplace(Struct);
+    }
+
+    bPendingStructsGathered = true;
+
+    UE_LOG(LogRemEditorUtilities, Verbose, TEXT("Prewarming property layout data of %d types"),
+        PendingStructs.Num());
+
+    return true;
+}
+
+void FPropertyLayoutCache::RestartGathering()
+{
+    // structs pending are found again
+    PendingStructs.Reset();
+    GatherObjectIndex       = 0;
+    bPendingStructsGathered = false;
+}
+
+bool FPropertyLayoutCache::IsCustomized(const FProperty& Property) const
+{
+    // container elements are customized the same way, @see FPropertyCustomizationDescriptor::IsElementSupported
+    const FProperty* KeyProperty{};
+    const FProperty* ValueProperty = &Property;
+
+    if (const auto* ArrayProperty = CastField<FArrayProperty>(&Property))
+    {
+        ValueProperty = ArrayProperty->Inner;
+    }
+    else if (const auto* SetProperty = CastField<FSetProperty>(&Property))
+    {
+        ValueProperty = SetProperty->ElementProp;
+    }
+    else if (const auto* MapProperty = CastField<FMapProperty>(&Property))
+    {
+        KeyProperty   = MapProperty->KeyProp;
+        ValueProperty = MapProperty->ValueProp;
+    }
+
+    return Descriptors.ContainsByPredicate(
+        [KeyProperty, ValueProperty](const FPropertyCustomizationDescriptor& Descriptor)
+        {
+            return Descriptor.IsCustomized(ValueProperty) || Descriptor.IsCustomized(KeyProperty);
+        });
+}
+
+bool FPropertyLayoutCache::HasCustomizedProperties(const UStruct& Struct) const
+{
+    for (TFieldIterator<FProperty> It(&Struct, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+    {
+        if (It->HasAnyPropertyFlags(CPF_Edit) && IsCustomized(**It))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FPropertyLayoutCache::IsCapacityReached() const
+{
+    const int32 MaxStructs = CVarLayoutPrewarmMaxStructs.GetValueOnGameThread();
+    return MaxStructs > 0 && StructLayouts.Num() >= MaxStructs;
+}
+
+void FPropertyLayoutCache::LaunchBatch()
+{
+    int32 BatchSize = CVarLayoutPrewarmBatchSize.GetValueOnGameThread();
+
+    // never go past the cap, @see IsCapacityReached
+    if (const int32 MaxStructs = CVarLayoutPrewarmMaxStructs.GetValueOnGameThread(); MaxStructs > 0)
+    {
+        BatchSize = FMath::Min(BatchSize, MaxStructs - StructLayouts.Num());
+    }
+
+    BatchSize = FMath::Max(1, BatchSize);
+
+    const auto Batch = MakeShared<FPrewarmBatch>();
+    while (!PendingStructs.IsEmpty() && Batch->Structs.Num() < BatchSize)
+    {
+        auto Struct = PendingStructs.Pop(EAllowShrinking::No);
+        if (const auto* RawStruct = Struct.Get();
+            RawStruct && !StructLayouts.Contains(RawStruct))
+        {
+            Batch->RawStructs.Add(RawStruct);
+            Batch->Structs.Add(MoveTemp(Struct));
+        }
+    }
+
+    if (Batch->Structs.IsEmpty())
+    {
+        return;
+    }
+
+    Batch->Results.SetNum(Batch->Structs.Num());
+
+    InFlightBatch = Batch;
+    InFlightTask  = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Batch]
+    {
+        // structs of the batch must not be collected while being read
+        FGCScopeGuard GCGuard;
+
+        ParallelFor(Batch->RawStructs.Num(), [&Batch](const int32 Index)
+        {
+            if (!Batch->bCancelRequested)
+            {
+                Batch->Results[Index] = MakeStructLayoutData(*Batch->RawStructs[Index]);
+            }
+        }, EParallelForFlags::BackgroundPriority);
+    }, UE::Tasks::ETaskPriority::BackgroundLow);
+}
+
+void FPropertyLayoutCache::PublishBatch()
+{
+    LLM_SCOPE_BYTAG(RemEditorUtilities);
+
+    for (int32 Index = 0; Index < InFlightBatch->Structs.Num(); ++Index)
+    {
+        const auto* Struct = InFlightBatch->Structs[Index].Get();
+        if (!Struct)
+        {
+            continue;
+        }
+
+        if (auto& Result = InFlightBatch->Results[Index])
+        {
+            INC_DWORD_STAT(STAT_RemLayoutDataStructsPrewarmed);
+
+            StructLayouts.Add(Struct, MoveTemp(Result.GetValue()));
+        }
+        else
+        {
+            // cancelled before reaching it
+            PendingStructs.Emplace(Struct);
+        }
+    }
+
+    InFlightBatch.Reset();
+    InFlightTask = {};
+}
+
+}
@@ -0,0 +1,117 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesPropertyPathCache.h"
+
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesStat.h"
+#include "Misc/StringBuilder.h"
+#include "UObject/UnrealType.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Property Paths Made"), STAT_RemPropertyPathsMade, STATGROUP_RemEditorUtilities);
+
+namespace Rem::Editor
+{
+
+FPropertyPathCache::FPropertyPathCache()
+{
+    RegisterInvalidation(TEXT("PropertyPathCache"),
+        EInvalidationReason::ReflectionChanged, FOnInvalidated::CreateLambda([this](EInvalidationReason)
+        {
+            Reset();
+        }));
+
+    RegisterMemReport(TEXT("PropertyPathCache"), FMemReportProvider::CreateLambda(
+        [this](TArray<FMemReportEntry>& OutEntries)
+        {
+            SIZE_T Bytes{PropertiesByPath.GetAllocatedSize()};
+            for (const auto& [Struct, StructProperties] : PropertiesByPath)
+            {
+                Bytes += StructProperties.GetAllocatedSize();
+            }
+
+            OutEntries.Add({TEXT("PathNames"), PathNames.Num(), PathNames.GetAllocatedSize()});
+            OutEntries.Add({TEXT("Structs"), PropertiesByPath.Num(), Bytes});
+        }));
+}
+
+FName FPropertyPathCache::GetPathName(const FProperty& Property)
+{
+    return FindOrAddPathName(Property);
+}
+
+const FProperty* FPropertyPathCache::FindProperty(const UStruct& OwnerStruct, const FName PathName)
+{
+    auto* StructProperties = PropertiesByPath.Find(&OwnerStruct);
+    if (!StructProperties)
+    {
+        LLM_SCOPE_BYTAG(RemEditorUtilities);
+
+        StructProperties = &PropertiesByPath.Add(&OwnerStruct);
+        for (TFieldIterator<FProperty> It(&OwnerStruct); It; ++It)
+        {
+            if (const FName PropertyPathName = FindOrAddPathName(**It);
+                !PropertyPathName.IsNone())
+            {
+                StructProperties->Add(PropertyPathName, TFieldPath<FProperty>{*It});
+            }
+        }
+    }
+
+    // resolved again by name if the struct is recompiled since
+    const auto* Property = StructProperties->Find(PathName);
+    return Property ? Property->Get() : nullptr;
+}
+
+void FPropertyPathCache::Reset()
+{
+    PathNames.Reset();
+    PropertiesByPath.Reset();
+}
+
+FName FPropertyPathCache::MakePathName(const FProperty& Property)
+{
+    INC_DWORD_STAT(STAT_RemPropertyPathsMade);
+
+    TStringBuilder<256> PathString;
+    Property.GetPathName(nullptr, PathString);
+
+    const FStringView PathView{PathString};
+
+    int32 Index;
+    if (!PathView.FindChar(TEXT(':'), Index))
+    {
+        return NAME_None;
+    }
+
+    const FStringView PropertyPath = PathView.RightChop(Index + 1);
+    return FName{PropertyPath.Len(), PropertyPath.GetData()};
+}
+
+FName FPropertyPathCache::FindOrAddPathName(const FProperty& Property)
+{
+    const FPathNameEntry Expected = MakePathNameEntry(Property, NAME_None);
+    if (const auto* Entry = PathNames.Find(&Property);
+        Entry && Entry->OwnerObject == Expected.OwnerObject && Entry->OwnerFieldName == Expected.OwnerFieldName
+        && Entry->PropertyName == Expected.PropertyName && Entry->FieldClass == Expected.FieldClass)
+    {
+        return Entry->PathName;
+    }
+
+    // not made yet, or made for another property at the same address
+    LLM_SCOPE_BYTAG(RemEditorUtilities);
+
+    return PathNames.Add(&Property, MakePathNameEntry(Property, MakePathName(Property))).PathName;
+}
+
+FPropertyPathCache::FPathNameEntry FPropertyPathCache::MakePathNameEntry(const FProperty& Property,
+    const FName PathName)
+{
+    const auto* OwnerField = Property.GetOwner<FField>();
+    return {
+        Property.GetOwnerUObject(), OwnerField ? OwnerField->GetFName() : NAME_None, Property.GetFName(),
+        Property.GetClass(), PathName
+    };
+}
+
+}
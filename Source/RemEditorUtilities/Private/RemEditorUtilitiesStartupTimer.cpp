@@ -0,0 +1,79 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesStartupTimer.h"
+
+#include "RemEditorUtilitiesLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+TAutoConsoleVariable CVarStartupBudget(TEXT("Rem.Editor.StartupBudgetMs"), 20.0f,
+    TEXT("Max milliseconds a startup step of the plugin modules should take, a warning is logged beyond it"));
+
+FAutoConsoleCommandWithOutputDevice StartupTimesCommand(TEXT("Rem.Editor.StartupTimes"),
+    TEXT("Print how long each startup step of the plugin modules took"),
+    FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&Rem::Editor::DumpStartupTimes));
+
+struct FStartupStep
+{
+    FName Name;
+    double Milliseconds{};
+};
+
+TArray<FStartupStep> StartupSteps;
+}
+
+namespace Rem::Editor
+{
+
+FScopedStartupTimer::FScopedStartupTimer(const TCHAR* InStepName)
+    : StepName(InStepName)
+    , StartTime(FPlatformTime::Seconds())
+{
+#if CPUPROFILERTRACE_ENABLED
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel))
+    {
+        FCpuProfilerTrace::OutputBeginDynamicEvent(InStepName);
+    }
+#endif
+}
+
+FScopedStartupTimer::~FScopedStartupTimer()
+{
+#if CPUPROFILERTRACE_ENABLED
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel))
+    {
+        FCpuProfilerTrace::OutputEndEvent();
+    }
+#endif
+
+    const double Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    StartupSteps.Add({StepName, Milliseconds});
+
+    if (const float Budget = CVarStartupBudget.GetValueOnGameThread();
+        Budget > 0.0f && Milliseconds > Budget)
+    {
+        UE_LOG(LogRemEditorUtilities, Warning, TEXT("%s took %.2f ms, over the startup budget of %.2f ms"),
+            *StepName.ToString(), Milliseconds, Budget);
+    }
+    else
+    {
+        UE_LOG(LogRemEditorUtilities, Log, TEXT("%s took %.2f ms"), *StepName.ToString(), Milliseconds);
+    }
+}
+
+void DumpStartupTimes(FOutputDevice& Ar)
+{
+    double TotalMilliseconds{};
+    for (const auto& [Name, Milliseconds] : StartupSteps)
+    {
+        Ar.Logf(TEXT("%-48s %8.2f ms"), *Name.ToString(), Milliseconds);
+        TotalMilliseconds += Milliseconds;
+    }
+
+    Ar.Logf(TEXT("%-48s %8.2f ms"), TEXT("Total"), TotalMilliseconds);
+}
+
+}
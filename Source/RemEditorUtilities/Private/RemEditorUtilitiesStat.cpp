@@ -0,0 +1,6 @@
+﻿// Copyright RemRemRemRe, All Rights Reserved.
+
+
+#include "RemEditorUtilitiesStat.h"
+
+LLM_DEFINE_TAG(RemEditorUtilities);
@@ -2,11 +2,19 @@
 
 #include "RemEditorUtilitiesStatics.h"
 
+#include "RemEditorUtilitiesPropertyLayout.h"
+#include "RemEditorUtilitiesPropertyPathCache.h"
+#include "RemEditorUtilitiesWidgetNameResolver.h"
 #include "DetailWidgetRow.h"
-#include "IDetailGroup.h"
+#include "PropertyHandle.h"
 #include "Components/Widget.h"
+#include "HAL/IConsoleManager.h"
 #include "Macro/RemAssertionMacros.h"
+#include "Misc/StringBuilder.h"
+#include "String/ParseTokens.h"
 #include "StructUtils/InstancedStruct.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/UnrealType.h"
 
 namespace Rem::Editor
 {
@@ -22,6 +30,9 @@ FAutoConsoleVariable CVarWidgetObjectPathAsWidgetName(
     TEXT("Rem.Editor.WidgetObjectPathAsWidgetName"), false,
     TEXT("Show widget object path as widget name"));
 
+TAutoConsoleVariable CVarPersistentPopupContent(TEXT("Rem.Editor.ComboButton.PersistentPopup"), true,
+    TEXT("Keep popup content of combo button pickers alive across opens, only refresh it when the source changes"));
+
 FText GetWidgetName(const UWidget* Widget)
 {
     if (!Widget)
@@ -41,7 +52,20 @@ FText GetWidgetName(const TSoftObjectPtr<const UWidget>& Widget)
         return FText::FromString(Widget.ToString());
     }
 
-    return GetWidgetName(Widget.Get());
+    return FWidgetNameResolver::Get().Resolve(Widget);
+}
+
+FName GetWidgetNameFromPath(const FSoftObjectPath& WidgetPath)
+{
+    const FString& SubPath = WidgetPath.GetSubPathString();
+
+    int32 Index;
+    if (!SubPath.FindLastChar(TEXT('.'), Index))
+    {
+        return SubPath.IsEmpty() ? NAME_None : FName(*SubPath);
+    }
+
+    return FName(*SubPath.RightChop(Index + 1));
 }
 
 bool IsInstancedStruct(const UScriptStruct* Struct)
@@ -49,6 +73,21 @@ bool IsInstancedStruct(const UScriptStruct* Struct)
     return Struct == FInstancedStruct::StaticStruct();
 }
 
+FName MakeIndexGroupName(const int32 Index)
+{
+    static const FStringView IndexPlaceholder{TEXT("{0}")};
+    static const int32 PlaceholderPosition = IndexFormat.Find(IndexPlaceholder.GetData());
+    check(PlaceholderPosition != INDEX_NONE);
+
+    const FStringView Format{IndexFormat};
+
+    TStringBuilder<64> GroupName;
+    GroupName << Format.Left(PlaceholderPosition) << Index
+        << Format.RightChop(PlaceholderPosition + IndexPlaceholder.Len());
+
+    return FName(GroupName.Len(), GroupName.GetData());
+}
+
 bool IsContainerElementValid(const TSharedRef<IPropertyHandle>& ElementHandle)
 {
     // whether the element has valid value
@@ -57,112 +96,246 @@ bool IsContainerElementValid(const TSharedRef<IPropertyHandle>& ElementHandle)
     return IsElementValid > 0;
 }
 
-IDetailGroup* MakePropertyGroups(TArray<TMap<FName, IDetailGroup*>>& ChildGroupLayerMapping,
+IDetailGroup* MakePropertyGroups(FChildGroupLayerMapping& ChildGroupLayerMapping,
     const FName PropertyGroupName)
 {
-    IDetailGroup* PropertyGroup = nullptr;
+    const FScopedGenerationPass Pass;
 
-    if (PropertyGroupName == NAME_None)
-    {
-        // no group property only show up at first layer
-        PropertyGroup = ChildGroupLayerMapping[0][NAME_None];
-    }
-    else
-    {
-        // add extra property group
-        const FString PropertyGroupString = PropertyGroupName.ToString();
-
-        TArray<FString> SplitCategoryString;
-        const int32 NumCategory = PropertyGroupString.ParseIntoArray(SplitCategoryString, TEXT("|"));
+    FPropertyLayoutModel Model;
+    TScratchArray<IDetailGroup*> ExternalGroups;
+    FLayoutGroupLayerMapping LayoutGroupLayerMapping;
+    AddExternalGroups(Model, ChildGroupLayerMapping, LayoutGroupLayerMapping, ExternalGroups);
 
-        // make sure size is big enough
-        if (ChildGroupLayerMapping.Num() < NumCategory)
-        {
-            ChildGroupLayerMapping.AddDefaulted(NumCategory - ChildGroupLayerMapping.Num());
-        }
+    const int32 PropertyGroup = MakePropertyLayoutGroups(Model, LayoutGroupLayerMapping, PropertyGroupName);
 
-        // build the group hierarchy from top(left) to bottom(right)
-        IDetailGroup* LastGroup = nullptr;
-        for (auto CategoryLayer = 0; CategoryLayer < NumCategory; ++CategoryLayer)
+    // groups only, nothing is customized
+    TArray<IDetailGroup*> Groups;
+    ApplyPropertyLayout(Model, {}, ExternalGroups,
+        [](TSharedRef<IPropertyHandle>, FDetailWidgetRow&, Enum::EContainerCombination)
         {
-            // remove space from start and end, ensuring category is properly retrieved
-            const FString CurrentCategoryString = SplitCategoryString[CategoryLayer].TrimStartAndEnd();
-
-            const FName CurrentCategoryName(*CurrentCategoryString);
-
-            if (PropertyGroup = ChildGroupLayerMapping[CategoryLayer].FindRef(CurrentCategoryName);
-                !PropertyGroup)
-            {
-                IDetailGroup* ParentGroup = CategoryLayer == 0
-                                                ? ChildGroupLayerMapping[0][NAME_None]
-                                                : LastGroup;
+        }, &Groups);
 
-                const FText InLocalizedDisplayName = FText::FromName(CurrentCategoryName);
-                PropertyGroup = &ParentGroup->AddGroup(CurrentCategoryName, InLocalizedDisplayName);
+    CollectLayoutGroups(LayoutGroupLayerMapping, Groups, ChildGroupLayerMapping);
 
-                ChildGroupLayerMapping[CategoryLayer].Add(CurrentCategoryName, PropertyGroup);
-            }
-
-            LastGroup = PropertyGroup;
-        }
-    }
-
-    return PropertyGroup;
+    return PropertyGroup != INDEX_NONE ? Groups[PropertyGroup] : nullptr;
 }
 
 void MakeCustomWidgetForProperty(const TSharedRef<IPropertyHandle>& PropertyHandle, FDetailWidgetRow& DetailPropertyRow,
     // ReSharper disable once CppPassValueParameterByConstReference
     const Enum::EContainerCombination ContainerType, const FMakePropertyWidgetFunctor Functor)
+{
+    MakeCustomWidgetLayout(PropertyHandle, DetailPropertyRow, ContainerType,
+        [&Functor](const TSharedRef<IPropertyHandle> FunctorHandle)
+        {
+            return WrapPropertyWidget(Functor(FunctorHandle));
+        });
+}
+
+TSharedRef<SWidget> WrapPropertyWidget(const TSharedRef<SWidget>& Content)
+{
+    return SNew(SHorizontalBox)
+        + SHorizontalBox::Slot()
+        .Padding(PropertyPadding)
+        .AutoWidth()
+        [
+            Content
+        ];
+}
+
+void MakeCustomWidgetLayout(const TSharedRef<IPropertyHandle>& PropertyHandle, FDetailWidgetRow& DetailPropertyRow,
+    // ReSharper disable once CppPassValueParameterByConstReference
+    const Enum::EContainerCombination ContainerType, const FMakePropertyWidgetFunctor MakeFunctorWidget)
 {
     using namespace Enum::BitOperation;
 
+    TSharedPtr<SWidget> NameWidget;
+    if (ContainerType == Enum::EContainerCombination::ContainerItself
+        || ContainerType == Enum::EContainerCombination::Struct
+        || EnumHasAnyFlags(ContainerType, Enum::EContainerCombination::Array))
+    {
+        NameWidget = WrapPropertyWidget(PropertyHandle->CreatePropertyNameWidget());
+    }
+    else if (ContainerType == Enum::EContainerCombination::Set)
+    {
+        NameWidget = WrapPropertyWidget(
+            PropertyHandle->CreatePropertyNameWidget(FText::AsNumber(PropertyHandle->GetIndexInArray())));
+    }
+    else if (EnumHasAllFlags(ContainerType, Enum::EContainerCombination::MapKey))
+    {
+        NameWidget = MakeFunctorWidget(PropertyHandle->GetKeyHandle().ToSharedRef());
+    }
+    else
+    {
+        NameWidget = WrapPropertyWidget(PropertyHandle->GetKeyHandle()->CreatePropertyValueWidget());
+    }
+
+    const TSharedRef<SWidget> ValueWidget = ContainerType == Enum::EContainerCombination::MapKey
+                                                // pass bDisplayDefaultPropertyButtons as false to prevent delete
+                                                // button get doubled
+                                                ? WrapPropertyWidget(PropertyHandle->CreatePropertyValueWidget(false))
+                                                : MakeFunctorWidget(PropertyHandle);
+
     DetailPropertyRow
         .NameContent()
         [
-            SNew(SHorizontalBox)
-            + SHorizontalBox::Slot()
-            .Padding(PropertyPadding)
-            .AutoWidth()
-            [
-                ContainerType == Enum::EContainerCombination::ContainerItself
-                || ContainerType == Enum::EContainerCombination::Struct
-                || EnumHasAnyFlags(ContainerType, Enum::EContainerCombination::Array)
-                    ? PropertyHandle->CreatePropertyNameWidget()
-
-                    : ContainerType == Enum::EContainerCombination::Set
-                    ? PropertyHandle->CreatePropertyNameWidget(FText::AsNumber(PropertyHandle->GetIndexInArray()))
-                    : EnumHasAllFlags(ContainerType, Enum::EContainerCombination::MapKey)
-                    ? Functor(PropertyHandle->GetKeyHandle().ToSharedRef())
-                    : PropertyHandle->GetKeyHandle()->CreatePropertyValueWidget()
-            ]
+            NameWidget.ToSharedRef()
         ]
         .ValueContent()
         [
-            SNew(SHorizontalBox)
-            + SHorizontalBox::Slot()
-            .Padding(PropertyPadding)
-            .AutoWidth()
-            [
-                ContainerType == Enum::EContainerCombination::MapKey
-                    // pass bDisplayDefaultPropertyButtons as false to prevent delete button get doubled
-                    ? PropertyHandle->CreatePropertyValueWidget(false)
-                    : Functor(PropertyHandle)
-            ]
+            ValueWidget
         ];
 }
 
 FString GetPropertyPath(const FProperty* Property)
+{
+    const FName PathName = GetPropertyPathName(Property);
+    return PathName.IsNone() ? FString{} : PathName.ToString();
+}
+
+FName GetPropertyPathName(const FProperty* Property)
 {
     RemCheckVariable(Property, return {});
 
-    const FString PropertyPath = Property->GetPathName();
+    return FPropertyPathCache::Get().GetPathName(*Property);
+}
+
+namespace
+{
+struct FPropertyPathTrieNode
+{
+    FName MemberName;
 
-    int32 Index;
-    if (!PropertyPath.FindChar(TEXT(':'), Index))
+    /** index of the path ending at this node, INDEX_NONE if none */
+    int32 PathIndex{INDEX_NONE};
+
+    TArray<int32, TInlineAllocator<4>> Children;
+};
+
+void WalkPropertyPathTrie(const TConstArrayView<FPropertyPathTrieNode> Nodes, const int32 NodeIndex,
+    const TSharedRef<IPropertyHandle>& Handle, const TConstArrayView<FName> PropertyPaths,
+    TMap<FName, TSharedRef<IPropertyHandle>>& OutHandles)
+{
+    const auto& Node = Nodes[NodeIndex];
+    if (Node.PathIndex != INDEX_NONE)
+    {
+        OutHandles.Add(PropertyPaths[Node.PathIndex], Handle);
+    }
+
+    if (Node.Children.IsEmpty())
+    {
+        return;
+    }
+
+    uint32 NumChildren{};
+    Handle->GetNumChildren(NumChildren);
+
+    int32 NumResolved{};
+    for (uint32 ChildIndex = 0; ChildIndex < NumChildren && NumResolved < Node.Children.Num(); ++ChildIndex)
     {
-        return {};
+        const auto ChildHandle    = Handle->GetChildHandle(ChildIndex);
+        const auto* ChildProperty = ChildHandle.IsValid() ? ChildHandle->GetProperty() : nullptr;
+        if (!ChildProperty)
+        {
+            continue;
+        }
+
+        const FName ChildName = ChildProperty->GetFName();
+        for (const int32 ChildNodeIndex : Node.Children)
+        {
+            if (Nodes[ChildNodeIndex].MemberName == ChildName)
+            {
+                ++NumResolved;
+                WalkPropertyPathTrie(Nodes, ChildNodeIndex, ChildHandle.ToSharedRef(), PropertyPaths, OutHandles);
+                break;
+            }
+        }
     }
-    return PropertyPath.RightChop(Index + 1)/*.Replace(TEXT(":"), TEXT("."))*/;
+}
+}
+
+TMap<FName, TSharedRef<IPropertyHandle>> ResolveChildHandles(const TSharedRef<IPropertyHandle>& RootHandle,
+    const TConstArrayView<FName> PropertyPaths)
+{
+    // node 0 is the root handle
+    TArray<FPropertyPathTrieNode, TInlineAllocator<16>> Nodes;
+    Nodes.AddDefaulted();
+
+    TStringBuilder<256> PathString;
+    for (int32 PathIndex = 0; PathIndex < PropertyPaths.Num(); ++PathIndex)
+    {
+        PathString.Reset();
+        PropertyPaths[PathIndex].AppendString(PathString);
+
+        int32 NodeIndex{};
+        UE::String::ParseTokens(PathString.ToView(), TEXT('.'),
+            [&Nodes, &NodeIndex](const FStringView Token)
+            {
+                const FName MemberName{Token.Len(), Token.GetData()};
+
+                if (const auto* ChildNodeIndex = Nodes[NodeIndex].Children.FindByPredicate(
+                    [&Nodes, &MemberName](const int32 Index)
+                    {
+                        return Nodes[Index].MemberName == MemberName;
+                    }))
+                {
+                    NodeIndex = *ChildNodeIndex;
+                    return;
+                }
+
+                const int32 NewNodeIndex = Nodes.AddDefaulted();
+                Nodes[NewNodeIndex].MemberName = MemberName;
+                Nodes[NodeIndex].Children.Add(NewNodeIndex);
+
+                NodeIndex = NewNodeIndex;
+            }, UE::String::EParseTokensOptions::SkipEmpty | UE::String::EParseTokensOptions::Trim);
+
+        if (NodeIndex != 0)
+        {
+            Nodes[NodeIndex].PathIndex = PathIndex;
+        }
+    }
+
+    TMap<FName, TSharedRef<IPropertyHandle>> Handles;
+    Handles.Reserve(PropertyPaths.Num());
+
+    WalkPropertyPathTrie(Nodes, 0, RootHandle, PropertyPaths, Handles);
+
+    return Handles;
+}
+
+bool HasMultipleValues(const FProperty& Property, const TConstArrayView<void*> ValuePtrs)
+{
+    if (ValuePtrs.Num() <= 1)
+    {
+        return false;
+    }
+
+    const void* FirstValue = ValuePtrs[0];
+    for (int32 Index = 1; Index < ValuePtrs.Num(); ++Index)
+    {
+        if (!Property.Identical(FirstValue, ValuePtrs[Index]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+FSoftObjectPath GetSoftObjectPath(const FObjectPropertyBase& ObjectProperty, const void* ValuePtr)
+{
+    RemCheckVariable(ValuePtr, return {};);
+
+    if (const auto* SoftObjectProperty = CastField<FSoftObjectProperty>(&ObjectProperty))
+    {
+        return SoftObjectProperty->GetPropertyValue(ValuePtr).ToSoftObjectPath();
+    }
+
+    return FSoftObjectPath{ObjectProperty.GetObjectPropertyValue(ValuePtr)};
+}
+
+bool IsPersistentPopupContentEnabled()
+{
+    return CVarPersistentPopupContent.GetValueOnGameThread();
 }
 
 FText TryGetText(const FPropertyAccess::Result Result, const TFunctionRef<FText()>& Predicate)
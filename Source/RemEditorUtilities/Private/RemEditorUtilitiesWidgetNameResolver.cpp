@@ -0,0 +1,159 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesWidgetNameResolver.h"
+
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesStat.h"
+#include "RemEditorUtilitiesStatics.h"
+#include "RemEditorUtilitiesWidgetTreeIndex.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Components/Widget.h"
+#include "HAL/IConsoleManager.h"
+#include "Macro/RemAssertionMacros.h"
+#include "UObject/Package.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+TAutoConsoleVariable CVarWidgetNameAsyncLoad(TEXT("Rem.Editor.WidgetName.AsyncLoad"), false,
+    TEXT("Load the owning asset of unloaded soft widget references asynchronously, to refresh their names"));
+
+}
+
+namespace Rem::Editor
+{
+
+FWidgetNameResolver::FWidgetNameResolver()
+{
+    OnAssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FWidgetNameResolver::OnAssetLoaded);
+
+    // provisional names are derived from soft paths, which no longer point to the same asset
+    RegisterInvalidation(TEXT("WidgetNameResolver"),
+        EInvalidationReason::AssetRenamed | EInvalidationReason::AssetRemoved,
+        FOnInvalidated::CreateLambda([this](EInvalidationReason)
+        {
+            Reset();
+        }));
+
+    RegisterMemReport(TEXT("WidgetNameResolver"), FMemReportProvider::CreateLambda(
+        [this](TArray<FMemReportEntry>& OutEntries)
+        {
+            int64 NumEntries{};
+            SIZE_T Bytes{UnresolvedEntries.GetAllocatedSize()};
+
+            for (const auto& [PackageName, PackageEntries] : UnresolvedEntries)
+            {
+                NumEntries += PackageEntries.Num();
+                Bytes += PackageEntries.GetAllocatedSize();
+            }
+
+            OutEntries.Add({TEXT("UnresolvedPackages"), UnresolvedEntries.Num(), Bytes});
+            OutEntries.Add({TEXT("UnresolvedEntries"), NumEntries, 0});
+        }));
+}
+
+FWidgetNameResolver::~FWidgetNameResolver()
+{
+    FCoreUObjectDelegates::OnAssetLoaded.Remove(OnAssetLoadedHandle);
+}
+
+FText FWidgetNameResolver::Resolve(const TSoftObjectPtr<const UWidget>& Widget)
+{
+    if (const auto* LoadedWidget = Widget.Get())
+    {
+        return GetWidgetName(LoadedWidget);
+    }
+
+    const FSoftObjectPath& WidgetPath = Widget.ToSoftObjectPath();
+    if (WidgetPath.IsNull())
+    {
+        return FText::GetEmpty();
+    }
+
+    const FName PackageName = WidgetPath.GetLongPackageFName();
+
+    LLM_SCOPE_BYTAG(RemEditorUtilities);
+
+    auto& PackageEntries = UnresolvedEntries.FindOrAdd(PackageName);
+
+    FEntry* Entry = PackageEntries.Find(WidgetPath);
+    if (!Entry)
+    {
+        Entry = &PackageEntries.Add(WidgetPath, MakeEntry(WidgetPath));
+    }
+
+    if (Entry->State == EEntryState::Unresolved && CVarWidgetNameAsyncLoad.GetValueOnGameThread())
+    {
+        RequestAsyncLoad(PackageName, PackageEntries);
+    }
+
+    return Entry->Name;
+}
+
+void FWidgetNameResolver::Reset()
+{
+    UnresolvedEntries.Reset();
+}
+
+FWidgetNameResolver::FEntry FWidgetNameResolver::MakeEntry(const FSoftObjectPath& WidgetPath) const
+{
+    const FName WidgetName = GetWidgetNameFromPath(WidgetPath);
+
+    // owner is loaded, the widget could be found in the widget tree
+    if (const auto* Widget = FWidgetTreeIndexService::Get().FindWidgetByPath(WidgetPath))
+    {
+        return {GetWidgetName(Widget), EEntryState::Resolved};
+    }
+
+    const auto* AssetRegistry = IAssetRegistry::Get();
+    RemCheckVariable(AssetRegistry, return {FText::FromName(WidgetName), EEntryState::Missing};);
+
+    // don't bother loading an asset which doesn't exist
+    const FSoftObjectPath AssetPath{WidgetPath.GetAssetPath()};
+    const bool bAssetExists = AssetRegistry->GetAssetByObjectPath(AssetPath).IsValid();
+
+    return {FText::FromName(WidgetName), bAssetExists ? EEntryState::Unresolved : EEntryState::Missing};
+}
+
+void FWidgetNameResolver::RequestAsyncLoad(const FName PackageName, FPackageEntries& PackageEntries)
+{
+    // one load per package, for every entry waiting on it
+    for (auto& [WidgetPath, Entry] : PackageEntries)
+    {
+        if (Entry.State == EEntryState::Unresolved)
+        {
+            Entry.State = EEntryState::Loading;
+        }
+    }
+
+    LoadPackageAsync(PackageName.ToString(),
+        FLoadPackageAsyncDelegate::CreateLambda([PackageName](const FName&, UPackage*, EAsyncLoadingResult::Type)
+        {
+            if (auto* Resolver = TryGet())
+            {
+                Resolver->ResolvePackage(PackageName);
+            }
+        }));
+}
+
+void FWidgetNameResolver::ResolvePackage(const FName PackageName)
+{
+    if (UnresolvedEntries.Remove(PackageName) > 0)
+    {
+        OnNameResolvedDelegate.Broadcast();
+    }
+}
+
+void FWidgetNameResolver::OnAssetLoaded(UObject* Asset)
+{
+    if (!Asset || UnresolvedEntries.IsEmpty())
+    {
+        return;
+    }
+
+    ResolvePackage(Asset->GetPackage()->GetFName());
+}
+
+}
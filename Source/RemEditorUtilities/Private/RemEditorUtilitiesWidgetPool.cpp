@@ -0,0 +1,211 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesWidgetPool.h"
+
+#include "DetailWidgetRow.h"
+#include "PropertyHandle.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesStat.h"
+#include "RemEditorUtilitiesStatics.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Widgets Reused"), STAT_RemPooledWidgetsReused,
+    STATGROUP_RemEditorUtilities);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Widgets Created"), STAT_RemPooledWidgetsCreated,
+    STATGROUP_RemEditorUtilities);
+
+namespace
+{
+TAutoConsoleVariable CVarWidgetPoolEnabled(TEXT("Rem.Editor.WidgetPool.Enabled"), true,
+    TEXT("Reuse custom row widgets made by MakePooledCustomWidgetForProperty"));
+
+TAutoConsoleVariable CVarWidgetPoolMaxPerKey(TEXT("Rem.Editor.WidgetPool.MaxPerKey"), 64,
+    TEXT("Max free widgets kept per container type and functor key, the rest are dropped when released"));
+
+TAutoConsoleVariable CVarWidgetPoolTrimSeconds(TEXT("Rem.Editor.WidgetPool.TrimSeconds"), 60.0f,
+    TEXT("Free widgets unused for longer than this are dropped"));
+
+/** how often free lists are trimmed */
+constexpr float TrimInterval = 5.0f;
+
+}
+
+namespace Rem::Editor
+{
+
+void FPropertyWidgetBinding::Bind(const TSharedRef<IPropertyHandle>& InPropertyHandle,
+    const TWeakPtr<IPropertyTypeCustomization>& InCustomization)
+{
+    PropertyHandle = InPropertyHandle;
+    Customization  = InCustomization;
+}
+
+void FPropertyWidgetBinding::Unbind()
+{
+    PropertyHandle.Reset();
+    Customization.Reset();
+}
+
+FPropertyWidgetPool::FPropertyWidgetPool()
+{
+    TrimTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this,
+        &FPropertyWidgetPool::Trim), TrimInterval);
+
+    RegisterMemReport(TEXT("PropertyWidgetPool"), FMemReportProvider::CreateLambda(
+        [this](TArray<FMemReportEntry>& OutEntries)
+        {
+            for (const auto& [Key, Pool] : Pools)
+            {
+                const auto Name = FString::Printf(TEXT("%s[%d]"), *Key.FunctorKey.ToString(),
+                    static_cast<int32>(Key.ContainerType));
+
+                OutEntries.Add({Name + TEXT(".Free"), Pool.FreeWidgets.Num(), Pool.FreeWidgets.GetAllocatedSize()});
+                OutEntries.Add({Name + TEXT(".InUse"), Pool.NumInUse, 0});
+            }
+        }));
+}
+
+FPropertyWidgetPool::~FPropertyWidgetPool()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TrimTickerHandle);
+}
+
+TSharedRef<SWidget> FPropertyWidgetPool::Acquire(const Enum::EContainerCombination ContainerType,
+    const FName FunctorKey, const TSharedRef<IPropertyHandle>& PropertyHandle,
+    const TWeakPtr<IPropertyTypeCustomization>& Customization, FPooledWidgetOwner& Owner,
+    const FMakeBoundPropertyWidgetFunctor Functor)
+{
+    auto MakeWidget = [&Functor](const TSharedRef<FPropertyWidgetBinding>& Binding) -> TSharedRef<SWidget>
+    {
+        INC_DWORD_STAT(STAT_RemPooledWidgetsCreated);
+
+        return WrapPropertyWidget(Functor(Binding));
+    };
+
+    LLM_SCOPE_BYTAG(RemEditorUtilities);
+
+    if (!CVarWidgetPoolEnabled.GetValueOnGameThread())
+    {
+        const auto Binding = MakeShared<FPropertyWidgetBinding>();
+        Binding->Bind(PropertyHandle, Customization);
+
+        return MakeWidget(Binding);
+    }
+
+    const FPoolKey Key{ContainerType, FunctorKey};
+    auto& Pool = Pools.FindOrAdd(Key);
+    ++Pool.NumInUse;
+
+    // released along with the old customization, the widget could still be in a row of the old details view until
+    // slate tears it down, it's skipped until then instead of ending up with two parents
+    const int32 FreeIndex = Pool.FreeWidgets.FindLastByPredicate([](const FFreeWidget& FreeWidget)
+    {
+        return !FreeWidget.PooledWidget.Widget->GetParentWidget().IsValid();
+    });
+
+    if (FreeIndex != INDEX_NONE)
+    {
+        INC_DWORD_STAT(STAT_RemPooledWidgetsReused);
+
+        FPooledWidget PooledWidget = MoveTemp(Pool.FreeWidgets[FreeIndex].PooledWidget);
+        Pool.FreeWidgets.RemoveAt(FreeIndex, EAllowShrinking::No);
+
+        PooledWidget.Binding->Bind(PropertyHandle, Customization);
+        return Owner.Leases.Emplace_GetRef(Key, MoveTemp(PooledWidget)).Value.Widget;
+    }
+
+    const auto Binding = MakeShared<FPropertyWidgetBinding>();
+    Binding->Bind(PropertyHandle, Customization);
+
+    return Owner.Leases.Emplace_GetRef(Key, FPooledWidget{MakeWidget(Binding), Binding}).Value.Widget;
+}
+
+void FPropertyWidgetPool::Release(TArray<TPair<FPoolKey, FPooledWidget>>& Leases)
+{
+    auto* WidgetPool = TryGet();
+    if (!WidgetPool)
+    {
+        Leases.Reset();
+        return;
+    }
+
+    const int32 MaxPerKey    = CVarWidgetPoolMaxPerKey.GetValueOnGameThread();
+    const double ReleaseTime = FPlatformTime::Seconds();
+
+    for (auto& [Key, PooledWidget] : Leases)
+    {
+        auto* Pool = WidgetPool->Pools.Find(Key);
+        if (!Pool)
+        {
+            continue;
+        }
+
+        --Pool->NumInUse;
+        PooledWidget.Binding->Unbind();
+
+        if (Pool->FreeWidgets.Num() < MaxPerKey)
+        {
+            Pool->FreeWidgets.Add({MoveTemp(PooledWidget), ReleaseTime});
+        }
+    }
+
+    Leases.Reset();
+}
+
+void FPropertyWidgetPool::Reset()
+{
+    for (auto& [Key, Pool] : Pools)
+    {
+        Pool.FreeWidgets.Empty();
+    }
+}
+
+bool FPropertyWidgetPool::Trim(float DeltaTime)
+{
+    const double ExpireTime = FPlatformTime::Seconds() - CVarWidgetPoolTrimSeconds.GetValueOnGameThread();
+
+    for (auto It = Pools.CreateIterator(); It; ++It)
+    {
+        auto& [FreeWidgets, NumInUse] = It.Value();
+
+        // released in order, the expired ones are at the front
+        const int32 NumExpired = Algo::LowerBound(FreeWidgets, ExpireTime,
+            [](const FFreeWidget& FreeWidget, const double Time)
+            {
+                return FreeWidget.ReleaseTime < Time;
+            });
+
+        FreeWidgets.RemoveAt(0, NumExpired, EAllowShrinking::No);
+
+        if (FreeWidgets.IsEmpty() && NumInUse == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    return true;
+}
+
+FPooledWidgetOwner::~FPooledWidgetOwner()
+{
+    FPropertyWidgetPool::Release(Leases);
+}
+
+void MakePooledCustomWidgetForProperty(const TSharedRef<IPropertyHandle>& PropertyHandle,
+    FDetailWidgetRow& DetailPropertyRow, const Enum::EContainerCombination ContainerType, const FName FunctorKey,
+    // ReSharper disable once CppPassValueParameterByConstReference
+    const FMakeBoundPropertyWidgetFunctor Functor, FPooledWidgetOwner& Owner,
+    const TWeakPtr<IPropertyTypeCustomization>& Customization)
+{
+    auto& Pool = FPropertyWidgetPool::Get();
+
+    // same layout as MakeCustomWidgetForProperty, but the parts made by functor come from the pool
+    MakeCustomWidgetLayout(PropertyHandle, DetailPropertyRow, ContainerType,
+        [&](const TSharedRef<IPropertyHandle> FunctorHandle)
+        {
+            return Pool.Acquire(ContainerType, FunctorKey, FunctorHandle, Customization, Owner, Functor);
+        });
+}
+
+}
@@ -0,0 +1,256 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesWidgetTreeIndex.h"
+
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesStat.h"
+#include "RemEditorUtilitiesStatics.h"
+#include "WidgetBlueprint.h"
+#include "Blueprint/WidgetBlueprintGeneratedClass.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Widget.h"
+#include "Macro/RemAssertionMacros.h"
+
+namespace
+{
+
+/**
+ * @brief Remove the entry only if it's still the widget's, another widget could have taken the key over in the same
+ * update, eg: two widgets swapped their names
+ */
+template <typename KeyType>
+void RemoveOwnEntry(TMap<KeyType, TObjectKey<UWidget>>& Widgets, const KeyType& Key,
+    const TObjectKey<UWidget>& WidgetKey)
+{
+    if (const auto* Widget = Widgets.Find(Key);
+        Widget && *Widget == WidgetKey)
+    {
+        Widgets.Remove(Key);
+    }
+}
+
+void RemoveIndexedWidget(Rem::Editor::FWidgetTreeIndex& Index, const TObjectKey<UWidget>& WidgetKey,
+    const Rem::Editor::FWidgetTreeIndex::FIndexedWidget& IndexedWidget)
+{
+    RemoveOwnEntry(Index.WidgetsByName, IndexedWidget.Name, WidgetKey);
+    RemoveOwnEntry(Index.WidgetsByPath, IndexedWidget.Path, WidgetKey);
+
+    if (auto* ClassWidgets = Index.WidgetsByClass.Find(IndexedWidget.Class))
+    {
+        ClassWidgets->RemoveAllSwap([&WidgetKey](const TWeakObjectPtr<UWidget>& Widget)
+        {
+            return TObjectKey<UWidget>{Widget.Get()} == WidgetKey || !Widget.IsValid();
+        });
+    }
+}
+}
+
+namespace Rem::Editor
+{
+
+FWidgetTreeIndexService::FWidgetTreeIndexService()
+{
+    RegisterMemReport(TEXT("WidgetTreeIndex"), FMemReportProvider::CreateLambda(
+        [this](TArray<FMemReportEntry>& OutEntries)
+        {
+            int64 NumWidgets{};
+            SIZE_T Bytes{Indices.GetAllocatedSize()};
+
+            for (const auto& [WidgetBlueprint, Index] : Indices)
+            {
+                NumWidgets += Index.IndexedWidgets.Num();
+                Bytes += Index.WidgetsByName.GetAllocatedSize() + Index.WidgetsByPath.GetAllocatedSize()
+                    + Index.WidgetsByClass.GetAllocatedSize() + Index.IndexedWidgets.GetAllocatedSize();
+
+                for (const auto& [Class, Widgets] : Index.WidgetsByClass)
+                {
+                    Bytes += Widgets.GetAllocatedSize();
+                }
+            }
+
+            OutEntries.Add({TEXT("Blueprints"), Indices.Num(), Bytes});
+            OutEntries.Add({TEXT("Widgets"), NumWidgets, 0});
+        }));
+}
+
+FWidgetTreeIndexService::~FWidgetTreeIndexService()
+{
+    Reset();
+
+}
+
+const UWidget* FWidgetTreeIndexService::FindWidgetByName(const UWidgetBlueprint* WidgetBlueprint,
+    const FName WidgetName)
+{
+    const auto* Index = GetIndex(WidgetBlueprint);
+    if (!Index)
+    {
+        return nullptr;
+    }
+
+    const auto* Widget = Index->WidgetsByName.Find(WidgetName);
+    return Widget ? Widget->ResolveObjectPtr() : nullptr;
+}
+
+const UWidget* FWidgetTreeIndexService::FindWidgetByPath(const FSoftObjectPath& WidgetPath)
+{
+    const auto* Owner = FSoftObjectPath{WidgetPath.GetAssetPath()}.ResolveObject();
+
+    const auto* WidgetBlueprint = Cast<UWidgetBlueprint>(Owner);
+    if (const auto* GeneratedClass = Cast<UWidgetBlueprintGeneratedClass>(Owner))
+    {
+        WidgetBlueprint = Cast<UWidgetBlueprint>(GeneratedClass->ClassGeneratedBy);
+    }
+
+    const auto* Index = GetIndex(WidgetBlueprint);
+    if (!Index)
+    {
+        return nullptr;
+    }
+
+    if (const auto* Widget = Index->WidgetsByPath.Find(WidgetPath))
+    {
+        return Widget->ResolveObjectPtr();
+    }
+
+    // path of the widget tree archetype in generated class, the widget has the same name
+    const auto* Widget = Index->WidgetsByName.Find(GetWidgetNameFromPath(WidgetPath));
+    return Widget ? Widget->ResolveObjectPtr() : nullptr;
+}
+
+TArray<const UWidget*> FWidgetTreeIndexService::FindWidgetsByClass(const UWidgetBlueprint* WidgetBlueprint,
+    const UClass* WidgetClass)
+{
+    TArray<const UWidget*> Widgets;
+
+    const auto* Index = GetIndex(WidgetBlueprint);
+    if (!Index || !WidgetClass)
+    {
+        return Widgets;
+    }
+
+    for (const auto& [Class, ClassWidgets] : Index->WidgetsByClass)
+    {
+        if (const auto* IndexedClass = Class.ResolveObjectPtr();
+            !IndexedClass || !IndexedClass->IsChildOf(WidgetClass))
+        {
+            continue;
+        }
+
+        for (const auto& Widget : ClassWidgets)
+        {
+            if (const auto* ValidWidget = Widget.Get())
+            {
+                Widgets.Add(ValidWidget);
+            }
+        }
+    }
+
+    return Widgets;
+}
+
+void FWidgetTreeIndexService::Reset()
+{
+    for (auto& [WidgetBlueprintKey, Index] : Indices)
+    {
+        if (auto* WidgetBlueprint = WidgetBlueprintKey.ResolveObjectPtr())
+        {
+            WidgetBlueprint->OnChanged().Remove(Index.OnChangedHandle);
+            WidgetBlueprint->OnCompiled().Remove(Index.OnCompiledHandle);
+        }
+    }
+
+    Indices.Reset();
+}
+
+FWidgetTreeIndex* FWidgetTreeIndexService::GetIndex(const UWidgetBlueprint* WidgetBlueprint)
+{
+    if (!WidgetBlueprint || !WidgetBlueprint->WidgetTree)
+    {
+        return nullptr;
+    }
+
+    auto* Index = Indices.Find(WidgetBlueprint);
+    if (!Index)
+    {
+        // drop indices of garbage collected blueprints before adding a new one
+        for (auto It = Indices.CreateIterator(); It; ++It)
+        {
+            if (!It->Key.ResolveObjectPtr())
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        auto* MutableBlueprint = const_cast<UWidgetBlueprint*>(WidgetBlueprint);
+
+        Index                   = &Indices.Add(WidgetBlueprint);
+        Index->OnChangedHandle  = MutableBlueprint->OnChanged().AddRaw(this, &ThisClass::OnBlueprintChanged);
+        Index->OnCompiledHandle = MutableBlueprint->OnCompiled().AddRaw(this, &ThisClass::OnBlueprintChanged);
+    }
+
+    if (Index->bDirty)
+    {
+        LLM_SCOPE_BYTAG(RemEditorUtilities);
+
+        UpdateIndex(*WidgetBlueprint, *Index);
+    }
+
+    return Index;
+}
+
+void FWidgetTreeIndexService::UpdateIndex(const UWidgetBlueprint& WidgetBlueprint, FWidgetTreeIndex& Index) const
+{
+    Index.bDirty = false;
+
+    // widgets found by this walk are stamped with it, no set of visited widgets is made
+    const uint32 UpdateCount = ++Index.UpdateCount;
+
+    WidgetBlueprint.WidgetTree->ForEachWidget([&Index, UpdateCount](UWidget* Widget)
+    {
+        RemCheckVariable(Widget, return;);
+
+        const TObjectKey<UWidget> WidgetKey{Widget};
+
+        const FName WidgetName = Widget->GetFName();
+        if (auto* IndexedWidget = Index.IndexedWidgets.Find(WidgetKey))
+        {
+            if (IndexedWidget->Name == WidgetName)
+            {
+                // unchanged
+                IndexedWidget->LastSeenUpdate = UpdateCount;
+                return;
+            }
+
+            // renamed
+            RemoveIndexedWidget(Index, WidgetKey, *IndexedWidget);
+        }
+
+        auto& IndexedWidget = Index.IndexedWidgets.Add(WidgetKey,
+            {WidgetName, FSoftObjectPath{Widget}, TObjectKey<UClass>{Widget->GetClass()}, UpdateCount});
+
+        Index.WidgetsByName.Add(IndexedWidget.Name, WidgetKey);
+        Index.WidgetsByPath.Add(IndexedWidget.Path, WidgetKey);
+        Index.WidgetsByClass.FindOrAdd(IndexedWidget.Class).Add(Widget);
+    });
+
+    // removed
+    for (auto It = Index.IndexedWidgets.CreateIterator(); It; ++It)
+    {
+        if (It->Value.LastSeenUpdate != UpdateCount)
+        {
+            RemoveIndexedWidget(Index, It->Key, It->Value);
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FWidgetTreeIndexService::OnBlueprintChanged(UBlueprint* Blueprint)
+{
+    if (auto* Index = Indices.Find(TObjectKey<UWidgetBlueprint>{Cast<UWidgetBlueprint>(Blueprint)}))
+    {
+        Index->bDirty = true;
+    }
+}
+
+}
@@ -0,0 +1,115 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesGenerationPass.h"
+#include "RemEditorUtilitiesPropertyLayout.h"
+#include "RemEditorUtilitiesPropertyLayoutCache.h"
+#include "RemEditorUtilitiesTestTypes.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+LLM_DEFINE_TAG(RemGenerationPassTest);
+
+namespace
+{
+using namespace Rem;
+using namespace Rem::Editor;
+
+struct FPassAllocations
+{
+    /** heap bytes still allocated after the pass, only tracked when LLM is on */
+    int64 HeapBytes{};
+
+    /** arena bytes used by the traversal, before the pass releases them */
+    int32 ScratchBytes{};
+};
+
+/**
+ * @return heap bytes tracked by LLM under the tag of the test (allocations made in its scope on this thread) and the
+ * tag of the module (caches filled on demand on game thread)
+ */
+int64 GetTrackedHeapBytes()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    if (!FLowLevelMemTracker::IsEnabled())
+    {
+        return 0;
+    }
+
+    // amounts tracked by threads are only published on update
+    auto& MemTracker = FLowLevelMemTracker::Get();
+    MemTracker.UpdateStatsPerFrame();
+
+    return MemTracker.GetTagAmountForTracker(ELLMTracker::Default, TEXT("RemGenerationPassTest"), ELLMTagSet::None)
+        + MemTracker.GetTagAmountForTracker(ELLMTracker::Default, TEXT("RemEditorUtilities"), ELLMTagSet::None);
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief What GenerateWidgetForContainerContent does before applying anything: traverse the container into a model
+ */
+FPassAllocations RunLayoutPass(const TSharedRef<IPropertyHandle>& ElementsHandle)
+{
+    FPassAllocations Allocations;
+    const int64 HeapBytesBefore = GetTrackedHeapBytes();
+    {
+        LLM_SCOPE_BYTAG(RemGenerationPassTest);
+
+        const FScopedGenerationPass Pass;
+        const int32 ScratchBytesBefore = FMemStack::Get().GetByteCount();
+
+        FPropertyLayoutModel Model;
+        const int32 Group = Model.AddExternalGroup();
+        BuildContainerContentLayout(Model, Group, ElementsHandle, Model.AddRootHandle(),
+            FPropertyCustomizationDescriptor::Make<FObjectProperty, UObject>(), Enum::EContainerCombination::Array);
+
+        // nested passes of the traversal leave their scratch data to the outermost one
+        Allocations.ScratchBytes = FMemStack::Get().GetByteCount() - ScratchBytesBefore;
+    }
+    Allocations.HeapBytes = GetTrackedHeapBytes() - HeapBytesBefore;
+
+    return Allocations;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRemGenerationPassScratchAllocationsTest, "Rem.Editor.GenerationPass.ScratchAllocations",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRemGenerationPassScratchAllocationsTest::RunTest(const FString& Parameters)
+{
+    const Tests::FLayoutTestData TestData{32};
+    if (!TestValid(TEXT("Handle of the elements"), TestData.ElementsHandle))
+    {
+        return false;
+    }
+
+    const auto ElementsHandle = TestData.ElementsHandle.ToSharedRef();
+
+    // the first pass makes the layout data of the element struct on demand, and the arena pages it needs
+    FPropertyLayoutCache::Get().Reset();
+    const int32 ScratchBytesAtStart = FMemStack::Get().GetByteCount();
+
+    const FPassAllocations ColdPass = RunLayoutPass(ElementsHandle);
+    const FPassAllocations WarmPass = RunLayoutPass(ElementsHandle);
+
+    TestTrue(TEXT("Scratch data of the traversal is allocated from the arena"), WarmPass.ScratchBytes > 0);
+    TestEqual(TEXT("Scratch bytes of the same traversal"), WarmPass.ScratchBytes, ColdPass.ScratchBytes);
+    TestEqual(TEXT("Scratch bytes left after the passes"), FMemStack::Get().GetByteCount(), ScratchBytesAtStart);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    if (FLowLevelMemTracker::IsEnabled())
+    {
+        TestTrue(FString::Printf(TEXT("Heap bytes left by a warmed pass (%lld) are fewer than the first pass (%lld)"),
+            WarmPass.HeapBytes, ColdPass.HeapBytes), WarmPass.HeapBytes < ColdPass.HeapBytes);
+        return true;
+    }
+#endif
+
+    AddInfo(TEXT("LLM is off, run with -llm to check heap allocations of the passes"));
+    return true;
+}
+
+#endif
@@ -0,0 +1,140 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#include "RemEditorUtilitiesPropertyLayout.h"
+#include "RemEditorUtilitiesStatics.h"
+#include "RemEditorUtilitiesTestTypes.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+using namespace Rem;
+using namespace Rem::Editor;
+
+void BuildElementsLayout(FPropertyLayoutModel& Model, const TSharedRef<IPropertyHandle>& ElementsHandle)
+{
+    const FScopedGenerationPass Pass;
+
+    const int32 Group = Model.AddExternalGroup();
+    BuildContainerContentLayout(Model, Group, ElementsHandle, Model.AddRootHandle(),
+        FPropertyCustomizationDescriptor::Make<FObjectProperty, UObject>(), Enum::EContainerCombination::Array);
+}
+
+const FPropertyLayoutNode* FindNode(const FPropertyLayoutModel& Model, const EPropertyLayoutNodeKind Kind,
+    const int32 Parent, const FName Name)
+{
+    return Model.Nodes.FindByPredicate([&](const FPropertyLayoutNode& Node)
+    {
+        return Node.Kind == Kind && Node.Parent == Parent
+               && (Node.Kind == EPropertyLayoutNodeKind::PropertyRow ? Node.Property->GetFName() : Node.Name) == Name;
+    });
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRemPropertyLayoutModelTest, "Rem.Editor.PropertyLayout.Model",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRemPropertyLayoutModelTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumElements = 2;
+
+    const Tests::FLayoutTestData TestData{NumElements};
+    if (!TestValid(TEXT("Handle of the elements"), TestData.ElementsHandle))
+    {
+        return false;
+    }
+
+    const auto ElementsHandle = TestData.ElementsHandle.ToSharedRef();
+
+    FPropertyLayoutModel Model;
+    BuildElementsLayout(Model, ElementsHandle);
+
+    if (!TestFalse(TEXT("Model is empty"), Model.Nodes.IsEmpty()))
+    {
+        return false;
+    }
+
+    TestTrue(TEXT("First node is external"), Model.Nodes[0].Kind == EPropertyLayoutNodeKind::External);
+
+    for (int32 Index = 1; Index < Model.Nodes.Num(); ++Index)
+    {
+        const auto& Node = Model.Nodes[Index];
+
+        TestTrue(TEXT("Node made by the model is not external"), Node.Kind != EPropertyLayoutNodeKind::External);
+        if (!TestTrue(TEXT("Parent precedes its children"), Node.Parent >= 0 && Node.Parent < Index))
+        {
+            return false;
+        }
+
+        const auto ParentKind = Model.Nodes[Node.Parent].Kind;
+        TestTrue(TEXT("Parent is a group"),
+            ParentKind == EPropertyLayoutNodeKind::External || ParentKind == EPropertyLayoutNodeKind::Group);
+    }
+
+    for (int32 ElementIndex = 0; ElementIndex < NumElements; ++ElementIndex)
+    {
+        const auto* ElementNode = FindNode(Model, EPropertyLayoutNodeKind::Group, 0, MakeIndexGroupName(ElementIndex));
+        if (!TestNotNull(TEXT("Element group"), ElementNode))
+        {
+            return false;
+        }
+
+        // struct elements are laid out, not customized
+        TestFalse(TEXT("Element group is customized"), ElementNode->bCustomized);
+
+        const int32 ElementGroup = UE_PTRDIFF_TO_INT32(ElementNode - Model.Nodes.GetData());
+
+        const auto* OuterNode = FindNode(Model, EPropertyLayoutNodeKind::Group, ElementGroup, TEXT("Outer"));
+        if (!TestNotNull(TEXT("Outer category group"), OuterNode))
+        {
+            return false;
+        }
+
+        const int32 OuterGroup = UE_PTRDIFF_TO_INT32(OuterNode - Model.Nodes.GetData());
+
+        const auto* InnerNode = FindNode(Model, EPropertyLayoutNodeKind::Group, OuterGroup, TEXT("Inner"));
+        if (!TestNotNull(TEXT("Inner category group"), InnerNode))
+        {
+            return false;
+        }
+
+        const int32 InnerGroup = UE_PTRDIFF_TO_INT32(InnerNode - Model.Nodes.GetData());
+
+        const auto* ValueNode = FindNode(Model, EPropertyLayoutNodeKind::PropertyRow, InnerGroup,
+            GET_MEMBER_NAME_CHECKED(FRemLayoutTestElement, Value));
+        TestNotNull(TEXT("Row of Value in the inner category"), ValueNode);
+
+        const auto* ObjectNode = FindNode(Model, EPropertyLayoutNodeKind::PropertyRow, OuterGroup,
+            GET_MEMBER_NAME_CHECKED(FRemLayoutTestElement, Object));
+        if (TestNotNull(TEXT("Row of Object in the outer category"), ObjectNode))
+        {
+            TestTrue(TEXT("Object row is customized"), ObjectNode->bCustomized);
+        }
+
+        TestNotNull(TEXT("Row of the uncategorized member in the element group"), FindNode(Model,
+            EPropertyLayoutNodeKind::PropertyRow, ElementGroup,
+            GET_MEMBER_NAME_CHECKED(FRemLayoutTestElement, Uncategorized)));
+    }
+
+    // a refresh with the same handle tree lays out the same
+    FPropertyLayoutModel SameModel;
+    BuildElementsLayout(SameModel, ElementsHandle);
+
+    TestTrue(TEXT("Same layout of a refresh"), Model.IsSameLayout(SameModel));
+    TestTrue(TEXT("Same hash of a refresh"), Model.GetLayoutHash() == SameModel.GetLayoutHash());
+
+    // and a new element does not
+    const Tests::FLayoutTestData MoreTestData{NumElements + 1};
+    if (TestValid(TEXT("Handle of more elements"), MoreTestData.ElementsHandle))
+    {
+        FPropertyLayoutModel MoreModel;
+        BuildElementsLayout(MoreModel, MoreTestData.ElementsHandle.ToSharedRef());
+
+        TestFalse(TEXT("Same layout with a new element"), Model.IsSameLayout(MoreModel));
+    }
+
+    return true;
+}
+
+#endif
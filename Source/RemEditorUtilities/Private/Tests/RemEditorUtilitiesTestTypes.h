@@ -0,0 +1,97 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "IDetailTreeNode.h"
+#include "IPropertyRowGenerator.h"
+#include "PropertyEditorModule.h"
+#include "PropertyHandle.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/StructOnScope.h"
+
+#include "RemEditorUtilitiesTestTypes.generated.h"
+
+USTRUCT()
+struct FRemLayoutTestElement
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Outer|Inner")
+    int32 Value{};
+
+    UPROPERTY(EditAnywhere, Category = "Outer")
+    TObjectPtr<UObject> Object;
+
+    UPROPERTY(EditAnywhere)
+    float Uncategorized{};
+};
+
+USTRUCT()
+struct FRemLayoutTestStruct
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Layout")
+    TArray<FRemLayoutTestElement> Elements;
+};
+
+namespace Rem::Editor::Tests
+{
+
+/**
+ * @brief A FRemLayoutTestStruct and the handle of its Elements, made by a property row generator,
+ * so the layout functions could run without any details view
+ */
+struct FLayoutTestData
+{
+    TSharedPtr<FStructOnScope> StructData;
+    TSharedPtr<IPropertyRowGenerator> RowGenerator;
+    TSharedPtr<IPropertyHandle> ElementsHandle;
+
+    explicit FLayoutTestData(const int32 NumElements)
+    {
+        StructData = MakeShared<FStructOnScope>(FRemLayoutTestStruct::StaticStruct());
+        reinterpret_cast<FRemLayoutTestStruct*>(StructData->GetStructMemory())->Elements.SetNum(NumElements);
+
+        auto& PropertyEditorModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>(TEXT("PropertyEditor"));
+        RowGenerator = PropertyEditorModule.CreatePropertyRowGenerator(FPropertyRowGeneratorArgs{});
+        RowGenerator->SetStructure(StructData);
+
+        const FName ElementsName = GET_MEMBER_NAME_CHECKED(FRemLayoutTestStruct, Elements);
+        for (const auto& RootNode : RowGenerator->GetRootTreeNodes())
+        {
+            ElementsHandle = FindPropertyHandle(RootNode, ElementsName);
+            if (ElementsHandle)
+            {
+                break;
+            }
+        }
+    }
+
+private:
+    static TSharedPtr<IPropertyHandle> FindPropertyHandle(const TSharedRef<IDetailTreeNode>& TreeNode,
+        const FName PropertyName)
+    {
+        if (const TSharedPtr<IPropertyHandle> PropertyHandle = TreeNode->CreatePropertyHandle();
+            PropertyHandle && PropertyHandle->GetProperty()
+            && PropertyHandle->GetProperty()->GetFName() == PropertyName)
+        {
+            return PropertyHandle;
+        }
+
+        TArray<TSharedRef<IDetailTreeNode>> Children;
+        TreeNode->GetChildren(Children);
+
+        for (const auto& Child : Children)
+        {
+            if (auto PropertyHandle = FindPropertyHandle(Child, PropertyName))
+            {
+                return PropertyHandle;
+            }
+        }
+
+        return {};
+    }
+};
+
+}
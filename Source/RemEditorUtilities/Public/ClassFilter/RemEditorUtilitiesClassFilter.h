@@ -12,6 +12,12 @@ struct REMEDITORUTILITIES_API FRemEditorUtilitiesClassFilter : IClassViewerFilte
     TSet<const UClass*> DisallowedClasses;
     EClassFlags DisallowedClassFlags{};
 
+    /** optional extra test of loaded classes, which passed all the other rules */
+    TFunction<bool(const UClass& Class)> ClassPredicate;
+
+    /** optional extra test of unloaded blueprint classes, which passed all the other rules */
+    TFunction<bool(const IUnloadedBlueprintData& UnloadedClassData)> UnloadedClassPredicate;
+
 protected:
     virtual bool IsClassAllowed(const FClassViewerInitializationOptions& InInitOptions, const UClass* InClass,
         TSharedRef<FClassViewerFilterFuncs> InFilterFuncs) override;
@@ -0,0 +1,52 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "UObject/ObjectKey.h"
+
+class IAssetEditorInstance;
+class UClass;
+class UObject;
+enum class EAssetEditorCloseReason : uint8;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief Class to asset editor instance cache, makes GetAssetEditorInstance a single hash probe.
+ * Entries (including misses) are dropped when an asset editor opens or closes, or reflection data changes
+ */
+class REMEDITORUTILITIES_API FAssetEditorInstanceCache : public TEditorCacheSingleton<FAssetEditorInstanceCache>
+{
+    TMap<TObjectKey<UClass>, IAssetEditorInstance*> EditorInstances;
+
+    FDelegateHandle OnAssetEditorOpenedHandle;
+    FDelegateHandle OnAssetEditorRequestCloseHandle;
+    FDelegateHandle OnAssetClosedInEditorHandle;
+
+    friend TEditorSingleton<FAssetEditorInstanceCache>;
+
+    FAssetEditorInstanceCache();
+
+public:
+    ~FAssetEditorInstanceCache();
+
+    /**
+     * @brief Find the opened asset editor of the blueprint generating the class
+     * @param Class blueprint generated class
+     * @return the asset editor instance, nullptr if the editor is not opened
+     */
+    IAssetEditorInstance* Find(UClass* Class);
+
+    void Reset();
+
+private:
+    void RemoveEntriesOf(const UObject* Asset);
+
+    void OnAssetEditorOpened(UObject* Asset);
+    void OnAssetEditorRequestClose(UObject* Asset, EAssetEditorCloseReason CloseReason);
+    void OnAssetClosedInEditor(UObject* Asset, IAssetEditorInstance* AssetEditorInstance);
+};
+
+}
@@ -0,0 +1,40 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesInvalidationBus.h"
+#include "RemEditorUtilitiesMemReport.h"
+#include "RemEditorUtilitiesSingleton.h"
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief Base of editor singleton caches, which report to "Rem.Editor.MemReport" and are dropped via
+ * FInvalidationBus. Registrations made through it are removed along with the instance
+ */
+template <typename T>
+class TEditorCacheSingleton : public TEditorSingleton<T>
+{
+    FDelegateHandle MemReportHandle;
+    FDelegateHandle InvalidationHandle;
+
+protected:
+    ~TEditorCacheSingleton()
+    {
+        FInvalidationBus::Unregister(InvalidationHandle);
+        FMemReport::Unregister(MemReportHandle);
+    }
+
+    void RegisterMemReport(const FName OwnerName, FMemReportProvider Provider)
+    {
+        MemReportHandle = FMemReport::Get().Register(OwnerName, MoveTemp(Provider));
+    }
+
+    void RegisterInvalidation(const FName CacheName, const EInvalidationReason Reasons, FOnInvalidated Delegate)
+    {
+        InvalidationHandle = FInvalidationBus::Get().Register(CacheName, Reasons, MoveTemp(Delegate));
+    }
+};
+
+}
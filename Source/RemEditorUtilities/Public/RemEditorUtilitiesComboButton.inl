@@ -6,6 +6,7 @@
 #include "Widgets/Input/SSearchBox.h"
 #include "PropertyHandle.h"
 #include "RemEditorUtilitiesStatics.h"
+#include "RemEditorUtilitiesWidgetPool.h"
 #include "DetailLayoutBuilder.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "Widgets/Views/SListView.h"
@@ -13,7 +14,11 @@
 namespace Rem::Editor
 {
 
-static TSharedRef<SWidget> MakeComboButton(const TSharedRef<IPropertyHandle>& PropertyHandle,
+/**
+ * @brief MakeComboButton for pooled widgets, @see FPropertyWidgetPool
+ * everything reads the property handle through the binding, so the combo button could be rebound
+ */
+static TSharedRef<SWidget> MakeComboButton(const TSharedRef<FPropertyWidgetBinding>& Binding,
     const TFunctionRef<FOnGetContent(TSharedRef<SComboButton>& ComboButton)>& GetOnGetMenuContent,
     const TAttribute<FText>& ComboButtonTextAttribute)
 {
@@ -23,7 +28,11 @@ static TSharedRef<SWidget> MakeComboButton(const TSharedRef<IPropertyHandle>& Pr
         .ButtonStyle(FAppStyle::Get(), AssetComboStyleName)
         .ForegroundColor(FAppStyle::GetColor(AssetNameColorName))
         .ContentPadding(2.0f)
-        .IsEnabled(!PropertyHandle->IsEditConst())
+        .IsEnabled_Lambda([Binding]
+        {
+            const auto& PropertyHandle = Binding->GetPropertyHandle();
+            return PropertyHandle.IsValid() && !PropertyHandle->IsEditConst();
+        })
         .ButtonContent()
         [
             SNew(STextBlock)
@@ -36,16 +45,42 @@ static TSharedRef<SWidget> MakeComboButton(const TSharedRef<IPropertyHandle>& Pr
     return ComboButton;
 }
 
-template <typename ItemType, typename FunctorGetFOnTextChanged, typename FunctorGetFGetCurrentValue>
-static TSharedRef<SWidget> GetPopupContent(const TSharedRef<SComboButton> WidgetListComboButton,
+/**
+ * @brief MakeComboButton of a widget made for the handle only (not pooled), bound to it once and for all
+ */
+static TSharedRef<SWidget> MakeComboButton(const TSharedRef<IPropertyHandle>& PropertyHandle,
+    const TFunctionRef<FOnGetContent(TSharedRef<SComboButton>& ComboButton)>& GetOnGetMenuContent,
+    const TAttribute<FText>& ComboButtonTextAttribute)
+{
+    const auto Binding = MakeShared<FPropertyWidgetBinding>();
+    Binding->Bind(PropertyHandle, {});
+
+    return MakeComboButton(Binding, GetOnGetMenuContent, ComboButtonTextAttribute);
+}
+
+template <typename ItemType>
+struct TPopupContentWidgets
+{
+    TSharedPtr<SWidget> MenuContent;
+    TSharedPtr<SListView<ItemType>> ListView;
+    TSharedPtr<SSearchBox> SearchBox;
+    FOnTextChanged OnTextChanged;
+};
+
+/**
+ * @brief Build popup content of a combo button picker, without filtering the list or selecting anything
+ */
+template <typename ItemType, typename FunctorGetFOnTextChanged>
+static TPopupContentWidgets<ItemType> BuildPopupContent(const TSharedRef<SComboButton>& WidgetListComboButton,
     TArray<ItemType>* ListItemsSource,
     typename SListView<ItemType>::FOnSelectionChanged OnSelectionChanged,
     typename SListView<ItemType>::FOnGenerateRow OnGenerateRow,
-    FunctorGetFGetCurrentValue /*TFunction<ItemType()>*/ MakeCurrentListItem,
     FunctorGetFOnTextChanged /*TFunction<FOnTextChanged(TSharedRef<SListView<ItemType>> ListView)>*/ GetOnTextChanged)
 {
     using namespace Rem::Editor;
 
+    TPopupContentWidgets<ItemType> Widgets;
+
     constexpr auto bInShouldCloseWindowAfterMenuSelection = true;
     constexpr auto bCloseSelfOnly                         = true;
     FMenuBuilder MenuBuilder(bInShouldCloseWindowAfterMenuSelection, nullptr, nullptr, bCloseSelfOnly);
@@ -59,22 +94,16 @@ static TSharedRef<SWidget> GetPopupContent(const TSharedRef<SComboButton> Widget
             .OnGenerateRow(OnGenerateRow)
             .SelectionMode(ESelectionMode::Single);
 
-        const FOnTextChanged OnTextChanged = GetOnTextChanged(WidgetListView);
-
-        // Ensure no filter is applied at the time the menu opens
-        OnTextChanged.Execute(FText::GetEmpty());
-
-        WidgetListView->SetSelection(MakeCurrentListItem());
-
-        TSharedPtr<SSearchBox> SearchBox;
+        Widgets.ListView      = WidgetListView;
+        Widgets.OnTextChanged = GetOnTextChanged(WidgetListView);
 
         const auto MenuContent =
             SNew(SVerticalBox)
             + SVerticalBox::Slot()
             .AutoHeight()
             [
-                SAssignNew(SearchBox, SSearchBox)
-                .OnTextChanged(OnTextChanged)
+                SAssignNew(Widgets.SearchBox, SSearchBox)
+                .OnTextChanged(Widgets.OnTextChanged)
             ]
             + SVerticalBox::Slot()
             .Padding(0, 2.0f, 0, 0)
@@ -89,13 +118,98 @@ static TSharedRef<SWidget> GetPopupContent(const TSharedRef<SComboButton> Widget
 
         MenuBuilder.AddWidget(MenuContent, FText::GetEmpty(), true);
 
-        WidgetListComboButton->SetMenuContentWidgetToFocus(SearchBox);
+        WidgetListComboButton->SetMenuContentWidgetToFocus(Widgets.SearchBox);
     }
     MenuBuilder.EndSection();
 
-    return MenuBuilder.MakeWidget();
+    Widgets.MenuContent = MenuBuilder.MakeWidget();
+    return Widgets;
 }
 
+template <typename ItemType, typename FunctorGetFOnTextChanged, typename FunctorGetFGetCurrentValue>
+static TSharedRef<SWidget> GetPopupContent(const TSharedRef<SComboButton> WidgetListComboButton,
+    TArray<ItemType>* ListItemsSource,
+    typename SListView<ItemType>::FOnSelectionChanged OnSelectionChanged,
+    typename SListView<ItemType>::FOnGenerateRow OnGenerateRow,
+    FunctorGetFGetCurrentValue /*TFunction<ItemType()>*/ MakeCurrentListItem,
+    FunctorGetFOnTextChanged /*TFunction<FOnTextChanged(TSharedRef<SListView<ItemType>> ListView)>*/ GetOnTextChanged)
+{
+    const auto Widgets = BuildPopupContent<ItemType>(WidgetListComboButton, ListItemsSource, OnSelectionChanged,
+        OnGenerateRow, GetOnTextChanged);
+
+    // Ensure no filter is applied at the time the menu opens
+    Widgets.OnTextChanged.Execute(FText::GetEmpty());
+
+    Widgets.ListView->SetSelection(MakeCurrentListItem());
+
+    return Widgets.MenuContent.ToSharedRef();
+}
+
+/**
+ * @brief Popup content of a combo button picker, built once and kept alive across opens.
+ * Reopening only refreshes the selection, the list is filtered again only if the source version changed or
+ * a filter is left from last open. Falls back to GetPopupContent when "Rem.Editor.ComboButton.PersistentPopup" is off
+ */
+template <typename ItemType>
+class TPersistentPopupContent
+{
+    TPopupContentWidgets<ItemType> Widgets;
+    const TArray<ItemType>* ListItemsSource{};
+    uint32 SourceVersion{};
+
+public:
+    /**
+     * @param InSourceVersion version of whatever the list items come from, eg: the class listing its functions
+     * @see GetPopupContent for the other parameters, delegates are only taken when the content is (re)built,
+     * so they shouldn't capture anything that changes between opens
+     */
+    template <typename FunctorGetFOnTextChanged, typename FunctorGetFGetCurrentValue>
+    TSharedRef<SWidget> GetOrBuild(const TSharedRef<SComboButton>& WidgetListComboButton,
+        TArray<ItemType>* InListItemsSource,
+        typename SListView<ItemType>::FOnSelectionChanged OnSelectionChanged,
+        typename SListView<ItemType>::FOnGenerateRow OnGenerateRow,
+        FunctorGetFGetCurrentValue /*TFunction<ItemType()>*/ MakeCurrentListItem,
+        FunctorGetFOnTextChanged /*TFunction<FOnTextChanged(TSharedRef<SListView<ItemType>> ListView)>*/
+        GetOnTextChanged,
+        const uint32 InSourceVersion)
+    {
+        if (!IsPersistentPopupContentEnabled())
+        {
+            Reset();
+            return GetPopupContent<ItemType>(WidgetListComboButton, InListItemsSource, OnSelectionChanged,
+                OnGenerateRow, MakeCurrentListItem, GetOnTextChanged);
+        }
+
+        if (!Widgets.MenuContent || ListItemsSource != InListItemsSource)
+        {
+            Widgets = BuildPopupContent<ItemType>(WidgetListComboButton, InListItemsSource, OnSelectionChanged,
+                OnGenerateRow, GetOnTextChanged);
+            ListItemsSource = InListItemsSource;
+
+            Widgets.OnTextChanged.Execute(FText::GetEmpty());
+        }
+        else if (SourceVersion != InSourceVersion || !Widgets.SearchBox->GetText().IsEmpty())
+        {
+            // Ensure no filter is applied at the time the menu opens
+            Widgets.SearchBox->SetText(FText::GetEmpty());
+            Widgets.OnTextChanged.Execute(FText::GetEmpty());
+        }
+
+        SourceVersion = InSourceVersion;
+
+        Widgets.ListView->SetSelection(MakeCurrentListItem());
+        WidgetListComboButton->SetMenuContentWidgetToFocus(Widgets.SearchBox);
+
+        return Widgets.MenuContent.ToSharedRef();
+    }
+
+    void Reset()
+    {
+        Widgets         = {};
+        ListItemsSource = nullptr;
+    }
+};
+
 // why typename FunctorGetText ?
 // @see https://stackoverflow.com/a/52508715
 template <typename ItemType, typename FunctorGetText>
@@ -114,4 +228,24 @@ static TSharedRef<ITableRow> OnGenerateListItem(const ItemType InItem,
             ];
 }
 
+// why typename FunctorGetText ?
+// @see https://stackoverflow.com/a/52508715
+template <typename ItemType, typename FunctorGetText, typename FunctorGetToolTipText>
+static TSharedRef<ITableRow> OnGenerateListItemWithToolTip(const ItemType InItem,
+    const TSharedRef<STableViewBase>& OwnerTable,
+    FunctorGetText/*TFunction<FText(const ItemType& Item)>*/ GetText,
+    FunctorGetToolTipText/*TFunction<FText(const ItemType& Item)>*/ GetToolTipText)
+{
+    using namespace Rem::Editor;
+
+    return
+            SNew(STableRow<ItemType>, OwnerTable)
+            .ToolTipText(GetToolTipText(InItem))
+            [
+                SNew(STextBlock)
+                .Font(IDetailLayoutBuilder::GetDetailFont())
+                .Text(GetText(InItem))
+            ];
+}
+
 }
@@ -0,0 +1,151 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "Misc/MemStack.h"
+#include "Misc/Optional.h"
+#include "Templates/SharedPointer.h"
+
+class IDetailGroup;
+class IPropertyHandle;
+
+namespace Rem::Editor
+{
+
+struct FMemReportEntry;
+
+/**
+ * Scratch containers allocated from the arena (FMemStack) of the running generation pass,
+ * released all at once when the outermost FScopedGenerationPass ends.
+ * Only create them inside a FScopedGenerationPass, and never let them outlive it
+ */
+template <typename ElementType>
+using TScratchArray = TArray<ElementType, TMemStackAllocator<>>;
+
+using FScratchSetAllocator = TSetAllocator<TSparseArrayAllocator<TMemStackAllocator<>, TMemStackAllocator<>>,
+    TMemStackAllocator<>>;
+
+template <typename KeyType, typename ValueType>
+using TScratchMap = TMap<KeyType, ValueType, FScratchSetAllocator>;
+
+/**
+ * layered group name to IDetailGroup mapping, @see GenerateWidgetsForNestedElement.
+ * Heap allocated, callers own it and could make it outside any generation pass
+ */
+using FChildGroupLayerMapping = TArray<TMap<FName, IDetailGroup*>>;
+
+enum class EGenerationGuardrail : uint8
+{
+    Depth,
+    Rows,
+};
+
+/**
+ * @brief Book keeping of a single widget generation pass (one top level call into the Generate* functions),
+ * limits how deep the traversal goes and how many rows it generates.
+ * Limits are read from "Rem.Editor.Generation.MaxDepth" and "Rem.Editor.Generation.MaxRows", non-positive means no limit,
+ * both are off by default
+ */
+struct REMEDITORUTILITIES_API FGenerationPass
+{
+    int32 MaxDepth{};
+    int32 MaxRows{};
+
+    int32 Depth{};
+    int32 NumRows{};
+
+    FGenerationPass();
+
+    /**
+     * @return the pass currently running on game thread, nullptr if there is none
+     */
+    static FGenerationPass* GetCurrent();
+
+    bool IsDepthExceeded() const;
+    bool IsRowsExceeded() const;
+
+    void AddRow()
+    {
+        ++NumRows;
+    }
+
+    /**
+     * @brief Lift the guardrails for the property (and its children) of the edited objects on next generation pass,
+     * then rebuild the children of its top level property, which only refreshes the details view owning the handle
+     */
+    static void ExpandOnDemand(const TSharedRef<IPropertyHandle>& PropertyHandle);
+
+    /**
+     * @return true if the property has been expanded on demand, for any of the edited objects
+     */
+    static bool IsExpandedOnDemand(const IPropertyHandle& PropertyHandle);
+
+    /**
+     * @brief Drop the expanded paths of destroyed objects, called after GC
+     */
+    static void PruneExpandedPaths();
+
+    static void ReportMemory(TArray<FMemReportEntry>& OutEntries);
+};
+
+/**
+ * @brief Begin a generation pass if there is none, nested scopes share the outermost pass.
+ * The outermost scope also dispatches pending invalidations, and marks the arena of scratch containers then pops it
+ * on destruction
+ */
+class REMEDITORUTILITIES_API FScopedGenerationPass : public FNoncopyable
+{
+    TOptional<FMemMark> ScratchMark;
+    TOptional<FGenerationPass> OwnedPass;
+    FGenerationPass* Pass{};
+    int32 ScratchByteCountAtStart{};
+
+public:
+    FScopedGenerationPass();
+    ~FScopedGenerationPass();
+
+    FGenerationPass& operator*() const
+    {
+        return *Pass;
+    }
+
+    FGenerationPass* operator->() const
+    {
+        return Pass;
+    }
+};
+
+/**
+ * @brief Step deeper in the generation pass,
+ * guardrails are lifted for the whole sub tree of a property that has been expanded on demand
+ */
+class REMEDITORUTILITIES_API FScopedGenerationDepth : public FNoncopyable
+{
+    FGenerationPass& Pass;
+    int32 DepthDelta;
+    int32 SavedMaxDepth;
+    int32 SavedMaxRows;
+
+public:
+    /**
+     * @param InPass the running generation pass
+     * @param PropertyHandle handle of the property whose children are about to be generated
+     * @param InDepthDelta 0 to only lift the guardrails (eg: generating children on the same depth)
+     */
+    FScopedGenerationDepth(FGenerationPass& InPass, const TSharedRef<IPropertyHandle>& PropertyHandle,
+        int32 InDepthDelta = 1);
+    ~FScopedGenerationDepth();
+};
+
+/**
+ * @brief Stop the traversal with an "Expand remaining (N items)" row, which continues the generation on demand
+ * @param Group group to add the placeholder row into
+ * @param PropertyHandle handle of the property whose children are not generated
+ * @param NumRemaining number of children not generated
+ * @param Guardrail the guardrail that has been hit
+ */
+REMEDITORUTILITIES_API void AddExpandRemainingRow(IDetailGroup& Group, const TSharedRef<IPropertyHandle>& PropertyHandle,
+    int32 NumRemaining, EGenerationGuardrail Guardrail);
+
+}
@@ -0,0 +1,135 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesSingleton.h"
+#include "Containers/Ticker.h"
+#include "Delegates/Delegate.h"
+
+struct FAssetData;
+class FOutputDevice;
+enum class EModuleChangeReason;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief What made derived editor data out of date
+ */
+enum class EInvalidationReason : uint8
+{
+    None               = 0,
+    BlueprintCompiled  = 1 << 0,
+    ObjectsReinstanced = 1 << 1,
+
+    /** hot reload or live coding patch */
+    CodeReloaded   = 1 << 2,
+    AssetRenamed   = 1 << 3,
+    AssetRemoved   = 1 << 4,
+
+    /** a module is loaded or unloaded, types already loaded are left as they are, only new ones show up */
+    ModulesChanged = 1 << 5,
+
+    /**
+     * types already loaded are changed, data derived from them is out of date.
+     * Not including ModulesChanged, caches gathering loaded types opt in to it, to pick up new ones
+     */
+    ReflectionChanged = BlueprintCompiled | ObjectsReinstanced | CodeReloaded,
+    All               = ReflectionChanged | ModulesChanged | AssetRenamed | AssetRemoved,
+};
+ENUM_CLASS_FLAGS(EInvalidationReason)
+
+/**
+ * @brief Reasons accumulated since the last dispatch
+ */
+using FOnInvalidated = TDelegate<void(EInvalidationReason Reasons)>;
+
+/**
+ * @brief Subscribes once to the engine delegates which make derived editor data out of date, and fans them out to
+ * registered caches. Events of a frame are coalesced into one call per cache on next tick, unless
+ * "Rem.Editor.Invalidation.Coalesce" is off.
+ * "Rem.Editor.Invalidation.Stats" prints how often each cache is invalidated
+ */
+class REMEDITORUTILITIES_API FInvalidationBus : public TEditorSingleton<FInvalidationBus>
+{
+    struct FRegistration
+    {
+        FDelegateHandle Handle;
+        FName CacheName;
+        EInvalidationReason Reasons{};
+        FOnInvalidated Delegate;
+    };
+
+    struct FCounters
+    {
+        /** times the delegate of the cache is called */
+        int32 NumInvalidations{};
+
+        /** engine events the cache is interested in, NumEvents - NumInvalidations were coalesced */
+        int32 NumEvents{};
+    };
+
+    TArray<FRegistration> Registrations;
+
+    /** by cache name, kept after unregistering so the numbers survive a cache being recreated */
+    TMap<FName, FCounters> Counters;
+
+    EInvalidationReason PendingReasons{};
+    int32 NumPendingEvents{};
+
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    /** GEditor is made after modules loaded at startup, its delegates are bound once engine init is done */
+    FDelegateHandle OnPostEngineInitHandle;
+    FDelegateHandle OnBlueprintCompiledHandle;
+    FDelegateHandle OnBlueprintReinstancedHandle;
+    FDelegateHandle OnObjectsReinstancedHandle;
+    FDelegateHandle OnReloadCompleteHandle;
+    FDelegateHandle OnAssetRenamedHandle;
+    FDelegateHandle OnAssetRemovedHandle;
+    FDelegateHandle OnModulesChangedHandle;
+
+    friend TEditorSingleton<FInvalidationBus>;
+
+    FInvalidationBus();
+
+public:
+    ~FInvalidationBus();
+
+    /**
+     * @brief Call the delegate whenever any of the reasons happens
+     * @param CacheName name shown in the stats, registrations of the same name share counters
+     * @param Reasons reasons the cache cares about
+     * @param Delegate called with the reasons happened, masked by Reasons
+     * @return handle to unregister with
+     */
+    FDelegateHandle Register(FName CacheName, EInvalidationReason Reasons, FOnInvalidated Delegate);
+
+    /**
+     * @brief Remove the registration, safe to call after the bus is shut down
+     */
+    static void Unregister(FDelegateHandle& Handle);
+
+    /**
+     * @brief Queue an invalidation, as if the engine reported it
+     */
+    void Invalidate(EInvalidationReason Reasons);
+
+    /**
+     * @brief Dispatch queued invalidations right away, for callers which can't wait for next tick.
+     * Caches are reset by it, only call it where nobody holds their entries, eg: at the start of a top level pass
+     */
+    void Flush();
+
+    void DumpStats(FOutputDevice& Ar) const;
+
+private:
+    void BindEditorDelegates();
+    bool Tick(float DeltaTime);
+
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnModulesChanged(FName ModuleName, EModuleChangeReason ChangeReason);
+};
+
+}
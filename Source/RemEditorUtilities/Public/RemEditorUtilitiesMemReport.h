@@ -0,0 +1,67 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesSingleton.h"
+
+class FOutputDevice;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief One line of "Rem.Editor.MemReport", eg: widgets pooled for a functor key
+ */
+struct REMEDITORUTILITIES_API FMemReportEntry
+{
+    FString Name;
+
+    /** instances, items or entries, depending on what is reported */
+    int64 Count{};
+
+    /** approximate, allocated size of containers plus what the entries own */
+    SIZE_T Bytes{};
+};
+
+using FMemReportProvider = TDelegate<void(TArray<FMemReportEntry>& OutEntries)>;
+
+/**
+ * @brief Registry of what editor caches, pools and customizations hold, printed by "Rem.Editor.MemReport".
+ * Every report prints the change since the previous one, so growth over a long session stands out.
+ * Allocations are also tracked by the "RemEditorUtilities" and "RemCommonEditor" LLM tags
+ */
+class REMEDITORUTILITIES_API FMemReport : public TEditorSingleton<FMemReport>
+{
+    struct FRegistration
+    {
+        FDelegateHandle Handle;
+        FName OwnerName;
+        FMemReportProvider Provider;
+    };
+
+    TArray<FRegistration> Registrations;
+
+    /** by "Owner.Entry", counts of the previous report */
+    TMap<FString, int64> PreviousCounts;
+
+    friend TEditorSingleton<FMemReport>;
+
+    FMemReport() = default;
+
+public:
+    /**
+     * @param OwnerName name of the cache or type, shown as the section of its entries
+     * @param Provider fill entries of the owner, called on game thread whenever a report is made
+     * @return handle to unregister with
+     */
+    FDelegateHandle Register(FName OwnerName, FMemReportProvider Provider);
+
+    /**
+     * @brief Remove the registration, safe to call after the registry is shut down
+     */
+    static void Unregister(FDelegateHandle& Handle);
+
+    void Dump(FOutputDevice& Ar);
+};
+
+}
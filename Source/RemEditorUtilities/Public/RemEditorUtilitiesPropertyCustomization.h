@@ -0,0 +1,98 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesGenerationPass.h"
+#include "Enum/RemContainerCombination.h"
+#include "Templates/RemPropertyHelper.h"
+
+class FDetailWidgetRow;
+class FFieldClass;
+class FProperty;
+class IDetailGroup;
+class IPropertyHandle;
+class UClass;
+
+namespace Rem::Editor
+{
+
+using FPropertyCustomizationFunctor =
+TFunctionRef<void(TSharedRef<IPropertyHandle> Handle, FDetailWidgetRow& WidgetPropertyRow,
+    Enum::EContainerCombination)>;
+
+/**
+ * @brief Which object properties a customization handles, the runtime form of the
+ * <PropertyType, PropertyBaseClass> template parameters of Generate* functions
+ */
+struct REMEDITORUTILITIES_API FPropertyCustomizationDescriptor
+{
+    /** FFieldClass of the object property type, eg: FObjectProperty::StaticClass() */
+    const FFieldClass* PropertyClass{};
+
+    /** objects referenced by the property must be of this class */
+    const UClass* BaseClass{};
+
+    template <CFObjectPropertyBase PropertyType, typename PropertyBaseClass>
+    static FPropertyCustomizationDescriptor Make()
+    {
+        return {PropertyType::StaticClass(), PropertyBaseClass::StaticClass()};
+    }
+
+    /**
+     * @return cast flag of PropertyClass itself, @see ClassifyProperty
+     */
+    uint64 GetObjectCastFlags() const;
+
+    /**
+     * @return whether the property is a PropertyClass referencing BaseClass or its children
+     */
+    bool IsCustomized(const FProperty* Property) const;
+
+    /**
+     * @return whether container elements of the property get generated, customized or struct
+     */
+    bool IsElementSupported(const FProperty* ElementProperty) const;
+};
+
+/**
+ * @brief Generate widget for container content (elements)
+ * @param ContainerHandle container property handle
+ * @param ContainerGroup container group
+ * @param Descriptor properties to customize
+ * @param Predicate property customization predicate
+ * @param ContainerType container type of PropertyHandle.
+ * use it to identify whether the PropertyHandle is the container itself or one of the child handle of the original container and its container type
+ */
+REMEDITORUTILITIES_API void GenerateWidgetForContainerContent(const TSharedRef<IPropertyHandle>& ContainerHandle,
+    IDetailGroup& ContainerGroup, const FPropertyCustomizationDescriptor& Descriptor,
+    FPropertyCustomizationFunctor Predicate, Enum::EContainerCombination ContainerType);
+
+/**
+ * @brief Generate widget for a container element
+ * @param ParentGroup container group
+ * @param ElementHandle element property handle
+ * @param Descriptor properties to customize
+ * @param Predicate property customization predicate
+ * @param ContainerType container type of PropertyHandle
+ */
+REMEDITORUTILITIES_API void GenerateWidgetForContainerElement(IDetailGroup& ParentGroup,
+    const TSharedRef<IPropertyHandle>& ElementHandle, const FPropertyCustomizationDescriptor& Descriptor,
+    FPropertyCustomizationFunctor Predicate, Enum::EContainerCombination ContainerType);
+
+/**
+ * @brief Generate widgets for nested element (properties of an array element)
+ * @param ElementHandle element property handle
+ * @param NumChildren children num of element property handle
+ * @param ChildGroupLayerMapping layered group name to IDetailGroup mapping.
+ * Note it must contain the "start point (no category group)" --- "ChildGroupLayerMapping[0][NAME_None]" element
+ * @param Layer Index of ChildGroupLayerMapping indicates which layer it should reside
+ * @param Descriptor properties to customize
+ * @param Predicate property customization predicate
+ * @param ContainerType container type of PropertyHandle
+ */
+REMEDITORUTILITIES_API void GenerateWidgetsForNestedElement(const TSharedRef<IPropertyHandle>& ElementHandle,
+    uint32 NumChildren, FChildGroupLayerMapping& ChildGroupLayerMapping, uint32 Layer,
+    const FPropertyCustomizationDescriptor& Descriptor, FPropertyCustomizationFunctor Predicate,
+    Enum::EContainerCombination ContainerType);
+
+}
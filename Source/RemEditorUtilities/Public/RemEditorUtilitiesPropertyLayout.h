@@ -0,0 +1,222 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesPropertyCustomization.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+namespace Rem::Editor
+{
+
+enum class EPropertyLayoutNodeKind : uint8
+{
+    // a group made outside the model, eg: the container group passed to Generate* functions
+    External,
+    // a group, with a header row if PropertyHandle is set (container header, container element or instanced struct)
+    Group,
+    // a property row
+    PropertyRow,
+    // "Expand remaining (N items)" row, @see AddExpandRemainingRow
+    ExpandRemaining,
+};
+
+struct REMEDITORUTILITIES_API FPropertyLayoutNode
+{
+    EPropertyLayoutNodeKind Kind{};
+
+    /** index of the parent group node, INDEX_NONE for external nodes */
+    int32 Parent{INDEX_NONE};
+
+    FName Name;
+    FText DisplayName;
+
+    /** index into the external groups of external nodes */
+    int32 ExternalIndex{INDEX_NONE};
+
+    /** property of the row, or of the group header, only compared with the bound handle, never dereferenced */
+    const FProperty* Property{};
+
+    /** the row or group header property, INDEX_NONE if there is none, @see FPropertyLayoutModel::HandlePaths */
+    int32 HandlePath{INDEX_NONE};
+
+    Enum::EContainerCombination ContainerType{};
+
+    /** the row (or group header) widget is made by the customization predicate */
+    bool bCustomized{};
+
+    /**
+     * concrete type the members of an instanced struct group are laid out for, members are not part of the model,
+     * ApplyPropertyLayout lays them out with Descriptor once the structure node of the handle is set up
+     */
+    TWeakObjectPtr<const UScriptStruct> InstancedStructType;
+    FPropertyCustomizationDescriptor Descriptor;
+
+    int32 NumRemaining{};
+    EGenerationGuardrail Guardrail{};
+};
+
+/**
+ * @brief Where a property handle is in the handle tree, as the child index under another path or a root handle
+ */
+struct FPropertyLayoutHandlePath
+{
+    /** path of the parent handle, INDEX_NONE if ChildIndex is the index of a root handle */
+    int32 Parent{INDEX_NONE};
+    int32 ChildIndex{};
+
+    bool operator==(const FPropertyLayoutHandlePath& Other) const
+    {
+        return Parent == Other.Parent && ChildIndex == Other.ChildIndex;
+    }
+};
+
+/**
+ * @brief Groups and rows the Generate* functions would add to a details view, as plain data.
+ * Nodes are stored in traversal order and every parent precedes its children, so it could be applied in one pass.
+ * Nodes keep their property and the path to its handle, not the handle itself, handles are only bound by
+ * ApplyPropertyLayout. Built without touching any detail group, so it could be compared between refreshes to skip
+ * no-op rebuilds, or benchmarked without a details view
+ */
+struct REMEDITORUTILITIES_API FPropertyLayoutModel
+{
+    TArray<FPropertyLayoutNode> Nodes;
+
+    /** parents precede their children */
+    TArray<FPropertyLayoutHandlePath> HandlePaths;
+
+    int32 NumExternalGroups{};
+    int32 NumRootHandles{};
+
+    /**
+     * @return node index of a group made outside the model, its index into the external groups is the order of adding
+     */
+    int32 AddExternalGroup();
+
+    int32 AddNode(FPropertyLayoutNode&& Node);
+
+    /**
+     * @return path of a handle passed to ApplyPropertyLayout, its index into the root handles is the order of adding
+     */
+    int32 AddRootHandle();
+
+    /**
+     * @return path of the child handle of the handle at ParentPath
+     */
+    int32 AddChildHandle(int32 ParentPath, uint32 ChildIndex);
+
+    void Reset();
+
+    /**
+     * @brief Structural equality: node kinds, hierarchy, names, properties (and the paths to their handles) and
+     * customization, property handles themselves are not compared as they are recreated on every refresh
+     */
+    bool IsSameLayout(const FPropertyLayoutModel& Other) const;
+
+    /**
+     * @return hash of what IsSameLayout compares
+     */
+    uint32 GetLayoutHash() const;
+};
+
+/**
+ * layered group name to node index mapping, the model version of FChildGroupLayerMapping.
+ * Allocated from the arena, only make it inside a FScopedGenerationPass, functions taking it check that
+ */
+using FLayoutGroupLayerMapping = TScratchArray<TScratchMap<FName, int32>>;
+
+/**
+ * @brief Add the groups already made by the caller as external nodes of the model
+ * @param ChildGroupLayerMapping groups already made
+ * @param OutLayoutGroupLayerMapping the same layers, mapped to the external nodes
+ * @param OutExternalGroups detail groups of the external nodes, to pass to ApplyPropertyLayout
+ */
+REMEDITORUTILITIES_API void AddExternalGroups(FPropertyLayoutModel& Model,
+    const FChildGroupLayerMapping& ChildGroupLayerMapping, FLayoutGroupLayerMapping& OutLayoutGroupLayerMapping,
+    TScratchArray<IDetailGroup*>& OutExternalGroups);
+
+/**
+ * @brief Hand the category groups made by ApplyPropertyLayout back to the caller
+ * @param LayoutGroupLayerMapping mapping the model is built with
+ * @param Groups detail group of each node, @see ApplyPropertyLayout
+ * @param ChildGroupLayerMapping the mapping passed to AddExternalGroups
+ */
+REMEDITORUTILITIES_API void CollectLayoutGroups(const FLayoutGroupLayerMapping& LayoutGroupLayerMapping,
+    TConstArrayView<IDetailGroup*> Groups, FChildGroupLayerMapping& ChildGroupLayerMapping);
+
+/**
+ * @brief Model version of MakePropertyGroups
+ * @return node index of the group of the category, INDEX_NONE if there is no group
+ */
+REMEDITORUTILITIES_API int32 MakePropertyLayoutGroups(FPropertyLayoutModel& Model,
+    FLayoutGroupLayerMapping& ChildGroupLayerMapping, FName PropertyGroupName);
+
+/**
+ * @brief MakePropertyLayoutGroups with the category already split, @see FPropertyLayoutData::CategoryPath
+ * @return node index of the group of the last category, INDEX_NONE if the path is empty
+ */
+REMEDITORUTILITIES_API int32 MakePropertyLayoutGroups(FPropertyLayoutModel& Model,
+    FLayoutGroupLayerMapping& ChildGroupLayerMapping, TConstArrayView<FName> CategoryPath);
+
+/**
+ * @brief Model version of GenerateWidgetForContainerContent
+ * @param Model model to add nodes into
+ * @param ContainerGroup node index of the container group
+ * @param ContainerHandle handle to read the layout from
+ * @param ContainerPath handle path of ContainerHandle in the model
+ */
+REMEDITORUTILITIES_API void BuildContainerContentLayout(FPropertyLayoutModel& Model, int32 ContainerGroup,
+    const TSharedRef<IPropertyHandle>& ContainerHandle, int32 ContainerPath,
+    const FPropertyCustomizationDescriptor& Descriptor, Enum::EContainerCombination ContainerType);
+
+/**
+ * @brief Model version of GenerateWidgetForContainerElement
+ * @param Model model to add nodes into
+ * @param ParentGroup node index of the container group
+ * @param ElementHandle handle to read the layout from
+ * @param ElementPath handle path of ElementHandle in the model
+ */
+REMEDITORUTILITIES_API void BuildContainerElementLayout(FPropertyLayoutModel& Model, int32 ParentGroup,
+    const TSharedRef<IPropertyHandle>& ElementHandle, int32 ElementPath,
+    const FPropertyCustomizationDescriptor& Descriptor, Enum::EContainerCombination ContainerType);
+
+/**
+ * @brief Model version of GenerateWidgetsForNestedElement.
+ * Instanced structs get a group for their current concrete type if worth it according to its plan, their members are
+ * laid out by ApplyPropertyLayout, @see FPropertyLayoutCache::FindInstancedStructPlan
+ * @param Model model to add nodes into
+ * @param ElementHandle handle to read the layout from
+ * @param ElementPath handle path of ElementHandle in the model
+ * @param ChildGroupLayerMapping must contain the "ChildGroupLayerMapping[0][NAME_None]" element
+ */
+REMEDITORUTILITIES_API void BuildNestedElementLayout(FPropertyLayoutModel& Model,
+    const TSharedRef<IPropertyHandle>& ElementHandle, int32 ElementPath, uint32 NumChildren,
+    FLayoutGroupLayerMapping& ChildGroupLayerMapping, uint32 Layer, const FPropertyCustomizationDescriptor& Descriptor,
+    Enum::EContainerCombination ContainerType);
+
+/**
+ * @brief Add the groups and rows of the model into detail groups, binding the handle of each node by its path.
+ * Nodes whose handle is gone or no longer of their property are skipped, along with their children.
+ * Instanced struct groups get the structure node of their handle set up once, and their members laid out
+ * @param Model the model to apply
+ * @param RootHandles handles of the root paths, in the order they are added
+ * @param ExternalGroups detail groups of the external nodes, in the order they are added
+ * @param Predicate make the widgets of customized nodes
+ * @param OutGroups optional, detail group of each node, null for rows and skipped nodes
+ */
+REMEDITORUTILITIES_API void ApplyPropertyLayout(const FPropertyLayoutModel& Model,
+    TConstArrayView<TSharedRef<IPropertyHandle>> RootHandles, TConstArrayView<IDetailGroup*> ExternalGroups,
+    FPropertyCustomizationFunctor Predicate, TArray<IDetailGroup*>* OutGroups = nullptr);
+
+/**
+ * @brief Refresh callback of a container, for GenerateContainerHeader. The content is only refreshed (and applied
+ * again) when it would be laid out differently, eg: an element is added, but not when a member of an element is edited
+ * @param ContainerHandle the container, its content is laid out by GenerateWidgetForContainerContent
+ * @param Descriptor the same as GenerateWidgetForContainerContent
+ * @param ContainerType the same as GenerateWidgetForContainerContent
+ * @param Refresh the actual refresh, eg: IPropertyUtilities::ForceRefresh
+ */
+REMEDITORUTILITIES_API FSimpleDelegate MakeContainerLayoutRefresh(const TSharedRef<IPropertyHandle>& ContainerHandle,
+    const FPropertyCustomizationDescriptor& Descriptor, Enum::EContainerCombination ContainerType,
+    FSimpleDelegate Refresh);
+
+}
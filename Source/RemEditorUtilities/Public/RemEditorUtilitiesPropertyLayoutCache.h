@@ -0,0 +1,184 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "RemEditorUtilitiesPropertyCustomization.h"
+#include "RemEditorUtilitiesPropertyVisitor.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class FField;
+class FProperty;
+class UScriptStruct;
+class UStruct;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief Reflection data the layout traversal reads for every property, @see BuildNestedElementLayout
+ */
+struct REMEDITORUTILITIES_API FPropertyLayoutData
+{
+    /**
+     * what the property was when the data is made, entries are keyed by property address (under their owner struct),
+     * which could be taken by another property once the owner struct is recompiled
+     */
+    const FFieldClass* FieldClass{};
+    FName PropertyName;
+
+    /** has CPF_Edit */
+    bool bEditable{};
+
+    /** @see FObjectEditorUtils::GetCategoryFName */
+    FName CategoryName;
+
+    /** CategoryName split by "|", trimmed, empty ones skipped */
+    TArray<FName> CategoryPath;
+
+    /** classified with FObjectPropertyBase as the object property type */
+    EPropertyVisitKind Kind{EPropertyVisitKind::Other};
+};
+
+/**
+ * @brief What the layout traversal does with an instanced struct of a concrete type, @see BuildNestedElementLayout
+ */
+struct REMEDITORUTILITIES_API FInstancedStructLayoutPlan
+{
+    /** editable object, container or struct properties (including inherited ones), the ones worth going into */
+    int32 NumTraversedMembers{};
+
+    /**
+     * what the type was when the plan is made, user defined structs are recompiled in place along with their
+     * properties. Only compared, never dereferenced
+     */
+    const FField* ChildProperties{};
+    int32 PropertiesSize{};
+
+    bool IsTraversed() const
+    {
+        return NumTraversedMembers != 0;
+    }
+
+    bool IsUpToDate(const UScriptStruct& ScriptStruct) const;
+};
+
+/**
+ * @brief Per UStruct FPropertyLayoutData of the properties declared in it, computed on first request.
+ * Loaded native structs and classes holding editable properties customized by any descriptor seen so far (directly
+ * or as container element) are prewarmed while the editor is idle: they are gathered in time slices on game thread,
+ * batches are computed on worker threads (reflection of native types is read only by then), and published on game
+ * thread. A batch in flight is cancelled as soon as the user interacts with the editor. Prewarming stops once the
+ * cache holds "Rem.Editor.LayoutPrewarm.MaxStructs" structs, the cost is reported by "Rem.Editor.MemReport".
+ * Controlled by "Rem.Editor.LayoutPrewarm.Enabled", "Rem.Editor.LayoutPrewarm.BatchSize",
+ * "Rem.Editor.LayoutPrewarm.GatherBudgetMs" and "Rem.Editor.LayoutPrewarm.IdleSeconds".
+ * Dropped when reflection changes, via FInvalidationBus, gathering is resumed for new types once modules are loaded.
+ * Data of user defined structs is dropped once they are edited, entries found out of date are remade on lookup
+ */
+class REMEDITORUTILITIES_API FPropertyLayoutCache : public TEditorCacheSingleton<FPropertyLayoutCache>
+{
+public:
+    using FStructLayoutData = TMap<const FProperty*, FPropertyLayoutData>;
+
+private:
+    struct FPrewarmBatch
+    {
+        TArray<TWeakObjectPtr<const UStruct>> Structs;
+        TArray<const UStruct*> RawStructs;
+
+        /** filled by worker threads, one per struct, unset if cancelled before reaching it */
+        TArray<TOptional<FStructLayoutData>> Results;
+
+        std::atomic<bool> bCancelRequested{};
+    };
+
+    TMap<TObjectKey<UStruct>, FStructLayoutData> StructLayouts;
+
+    /** by concrete type of instanced structs */
+    TMap<TObjectKey<UScriptStruct>, FInstancedStructLayoutPlan> InstancedStructPlans;
+
+    /** descriptors passed to the Generate* functions, only types customized by them are prewarmed */
+    TArray<FPropertyCustomizationDescriptor> Descriptors;
+
+    /** structs waiting to be prewarmed */
+    TArray<TWeakObjectPtr<const UStruct>> PendingStructs;
+
+    /** index into the object array to resume gathering from */
+    int32 GatherObjectIndex{};
+    bool bPendingStructsGathered{};
+
+    TSharedPtr<FPrewarmBatch> InFlightBatch;
+    UE::Tasks::FTask InFlightTask;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    /** drops the data of user defined structs once they are edited, @see FStructureEditorUtils */
+    struct FStructChangeListener;
+    TUniquePtr<FStructChangeListener> StructChangeListener;
+
+    friend TEditorSingleton<FPropertyLayoutCache>;
+
+    FPropertyLayoutCache();
+
+public:
+    ~FPropertyLayoutCache();
+
+    /**
+     * @return layout data of the property, computed right away if the owner struct is not prewarmed yet, or its data
+     * is out of date. nullptr if the property is not a member of a struct (eg: container inner property)
+     */
+    const FPropertyLayoutData* Find(const FProperty& Property);
+
+    /**
+     * @return plan of instanced structs of the concrete type, made on first request along with layout data of the
+     * type and its super structs, so traversing its instances computes nothing on demand afterward.
+     * Remade if the type is recompiled since
+     */
+    const FInstancedStructLayoutPlan& FindInstancedStructPlan(const UScriptStruct& ScriptStruct);
+
+    /**
+     * @brief Prewarm types customized by the descriptor as well, gathering starts over for a new descriptor
+     */
+    void AddDescriptor(const FPropertyCustomizationDescriptor& Descriptor);
+
+    /**
+     * @brief Cancel the batch in flight and wait for it, its results are dropped
+     */
+    void CancelPrewarm();
+
+    void Reset();
+
+    /**
+     * @brief Compute layout data of properties declared in the struct, only reads reflection data
+     */
+    static FStructLayoutData MakeStructLayoutData(const UStruct& Struct);
+
+private:
+    /**
+     * @brief Drop the layout data and plan of the struct, along with plans of types deriving from it
+     */
+    void DropStruct(const UStruct& Struct);
+
+    bool Tick(float DeltaTime);
+
+    /**
+     * @return true once all loaded structs are gathered
+     */
+    bool GatherPendingStructs();
+
+    /**
+     * @brief Walk the loaded types again, the ones already prewarmed are skipped
+     */
+    void RestartGathering();
+
+    bool IsCustomized(const FProperty& Property) const;
+    bool HasCustomizedProperties(const UStruct& Struct) const;
+    bool IsCapacityReached() const;
+    void LaunchBatch();
+    void PublishBatch();
+};
+
+}
@@ -0,0 +1,72 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "UObject/FieldPath.h"
+#include "UObject/ObjectKey.h"
+
+class FFieldClass;
+class FProperty;
+class UStruct;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief Interned property paths (@see GetPropertyPathName) keyed by property, and per owner struct reverse index from
+ * path to property, both built on first request, so querying them allocates nothing after warm-up.
+ * A struct recompiled in place (eg: blueprint class, user defined struct) could hand its property addresses over to
+ * new properties before the cache is dropped via FInvalidationBus, so paths are checked against the property they are
+ * made for, and the reverse index holds field paths, which resolve again once their owner struct is recompiled
+ */
+class REMEDITORUTILITIES_API FPropertyPathCache : public TEditorCacheSingleton<FPropertyPathCache>
+{
+    struct FPathNameEntry
+    {
+        /** what the property was when the path is made */
+        TObjectKey<UObject> OwnerObject;
+        FName OwnerFieldName;
+        FName PropertyName;
+        const FFieldClass* FieldClass{};
+
+        FName PathName;
+    };
+
+    TMap<const FProperty*, FPathNameEntry> PathNames;
+
+    /** by owner struct, path of every property (including inherited ones) to the property */
+    TMap<TObjectKey<UStruct>, TMap<FName, TFieldPath<FProperty>>> PropertiesByPath;
+
+    friend TEditorSingleton<FPropertyPathCache>;
+
+    FPropertyPathCache();
+
+public:
+    /**
+     * @return path of the property, NAME_None if it has no owner object
+     */
+    FName GetPathName(const FProperty& Property);
+
+    /**
+     * @brief Reverse of GetPathName, a hash lookup instead of walking the properties of the struct
+     * @param OwnerStruct struct owning the property, directly or through its super struct
+     * @param PathName path of the property, a member name for members of the struct
+     * @return the property, nullptr if not found
+     */
+    const FProperty* FindProperty(const UStruct& OwnerStruct, FName PathName);
+
+    void Reset();
+
+    /**
+     * @brief Compute the path of the property, without caching
+     */
+    static FName MakePathName(const FProperty& Property);
+
+private:
+    FName FindOrAddPathName(const FProperty& Property);
+
+    static FPathNameEntry MakePathNameEntry(const FProperty& Property, FName PathName);
+};
+
+}
@@ -0,0 +1,210 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesStatics.h"
+#include "Templates/RemPropertyHelper.h"
+#include "UObject/UnrealType.h"
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief What kind of property a visitor is handling, also the index of the dispatch table
+ */
+enum class EPropertyVisitKind : uint8
+{
+    Object,
+    Array,
+    Map,
+    Set,
+    Struct,
+    InstancedStruct,
+    Other,
+};
+
+namespace Private
+{
+struct FPropertyVisitKindEntry
+{
+    uint64 CastFlags;
+    EPropertyVisitKind Kind;
+};
+
+/**
+ * @brief Cast flags of each container property kind, the first matching entry wins
+ */
+inline constexpr FPropertyVisitKindEntry PropertyVisitKindTable[]
+{
+    {static_cast<uint64>(FArrayProperty::StaticClassCastFlagsPrivate()), EPropertyVisitKind::Array},
+    {static_cast<uint64>(FMapProperty::StaticClassCastFlagsPrivate()), EPropertyVisitKind::Map},
+    {static_cast<uint64>(FSetProperty::StaticClassCastFlagsPrivate()), EPropertyVisitKind::Set},
+    {static_cast<uint64>(FStructProperty::StaticClassCastFlagsPrivate()), EPropertyVisitKind::Struct},
+};
+}
+
+/**
+ * @brief Classify a property by the cast flags of its FFieldClass, without walking the class hierarchy
+ * @param Property property to classify
+ * @param ObjectCastFlags cast flag of the object property type to treat as EPropertyVisitKind::Object
+ */
+inline EPropertyVisitKind ClassifyProperty(const FProperty& Property, const uint64 ObjectCastFlags)
+{
+    const auto CastFlags = static_cast<uint64>(Property.GetClass()->GetCastFlags());
+
+    if (CastFlags & ObjectCastFlags)
+    {
+        return EPropertyVisitKind::Object;
+    }
+
+    for (const auto& [EntryCastFlags, Kind] : Private::PropertyVisitKindTable)
+    {
+        if (!(CastFlags & EntryCastFlags))
+        {
+            continue;
+        }
+
+        if (Kind == EPropertyVisitKind::Struct
+            && IsInstancedStruct(static_cast<const FStructProperty&>(Property).Struct))
+        {
+            return EPropertyVisitKind::InstancedStruct;
+        }
+
+        return Kind;
+    }
+
+    return EPropertyVisitKind::Other;
+}
+
+/**
+ * @brief Classify a property by the cast flags of its FFieldClass, without walking the class hierarchy
+ * @tparam PropertyType the object property type to treat as EPropertyVisitKind::Object
+ */
+template <CFObjectPropertyBase PropertyType>
+EPropertyVisitKind ClassifyProperty(const FProperty& Property)
+{
+    return ClassifyProperty(Property, static_cast<uint64>(PropertyType::StaticClassCastFlagsPrivate()));
+}
+
+/**
+ * @brief Base of property visitors, every unhandled kind falls back to "VisitOther" of the derived visitor
+ * @tparam Derived the visitor type
+ * @tparam PropertyType the object property type to treat as EPropertyVisitKind::Object
+ * @tparam ReturnType return type of all "Visit" functions
+ */
+template <typename Derived, CFObjectPropertyBase PropertyType, typename ReturnType = void>
+struct TPropertyVisitor
+{
+    using FObjectPropertyType = PropertyType;
+
+    ReturnType VisitObject(const PropertyType& Property)
+    {
+        return AsDerived().VisitOther(Property);
+    }
+
+    ReturnType VisitArray(const FArrayProperty& Property)
+    {
+        return AsDerived().VisitOther(Property);
+    }
+
+    ReturnType VisitMap(const FMapProperty& Property)
+    {
+        return AsDerived().VisitOther(Property);
+    }
+
+    ReturnType VisitSet(const FSetProperty& Property)
+    {
+        return AsDerived().VisitOther(Property);
+    }
+
+    ReturnType VisitStruct(const FStructProperty& Property)
+    {
+        return AsDerived().VisitOther(Property);
+    }
+
+    ReturnType VisitInstancedStruct(const FStructProperty& Property)
+    {
+        return AsDerived().VisitOther(Property);
+    }
+
+    ReturnType VisitOther(const FProperty& Property)
+    {
+        return ReturnType();
+    }
+
+private:
+    Derived& AsDerived()
+    {
+        return static_cast<Derived&>(*this);
+    }
+};
+
+/**
+ * @brief Dispatch the property to the typed "Visit" function of the visitor, through a jump table indexed by
+ * EPropertyVisitKind
+ * @tparam VisitorType @see TPropertyVisitor
+ * @param Property property to visit
+ * @param Visitor visitor
+ * @param Kind kind of the property, @see ClassifyProperty
+ * @return whatever the "Visit" function returns
+ */
+template <typename VisitorType>
+decltype(auto) VisitProperty(const FProperty& Property, VisitorType& Visitor, const EPropertyVisitKind Kind)
+{
+    using PropertyType = typename VisitorType::FObjectPropertyType;
+    using ReturnType   = decltype(Visitor.VisitOther(Property));
+    using FVisitThunk  = ReturnType(*)(const FProperty&, VisitorType&);
+
+    static constexpr FVisitThunk VisitThunks[]
+    {
+        [](const FProperty& InProperty, VisitorType& InVisitor) -> ReturnType
+        {
+            return InVisitor.VisitObject(static_cast<const PropertyType&>(InProperty));
+        },
+        [](const FProperty& InProperty, VisitorType& InVisitor) -> ReturnType
+        {
+            return InVisitor.VisitArray(static_cast<const FArrayProperty&>(InProperty));
+        },
+        [](const FProperty& InProperty, VisitorType& InVisitor) -> ReturnType
+        {
+            return InVisitor.VisitMap(static_cast<const FMapProperty&>(InProperty));
+        },
+        [](const FProperty& InProperty, VisitorType& InVisitor) -> ReturnType
+        {
+            return InVisitor.VisitSet(static_cast<const FSetProperty&>(InProperty));
+        },
+        [](const FProperty& InProperty, VisitorType& InVisitor) -> ReturnType
+        {
+            return InVisitor.VisitStruct(static_cast<const FStructProperty&>(InProperty));
+        },
+        [](const FProperty& InProperty, VisitorType& InVisitor) -> ReturnType
+        {
+            return InVisitor.VisitInstancedStruct(static_cast<const FStructProperty&>(InProperty));
+        },
+        [](const FProperty& InProperty, VisitorType& InVisitor) -> ReturnType
+        {
+            return InVisitor.VisitOther(InProperty);
+        },
+    };
+    static_assert(UE_ARRAY_COUNT(VisitThunks) == static_cast<uint8>(EPropertyVisitKind::Other) + 1);
+
+    return VisitThunks[static_cast<uint8>(Kind)](Property, Visitor);
+}
+
+/**
+ * @brief Dispatch the property to the typed "Visit" function of the visitor, classified by the object property type
+ * of the visitor
+ * @tparam VisitorType @see TPropertyVisitor
+ * @param Property property to visit
+ * @param Visitor visitor
+ * @return whatever the "Visit" function returns
+ */
+template <typename VisitorType>
+decltype(auto) VisitProperty(const FProperty& Property, VisitorType& Visitor)
+{
+    using PropertyType = typename VisitorType::FObjectPropertyType;
+
+    return VisitProperty(Property, Visitor, ClassifyProperty<PropertyType>(Property));
+}
+
+}
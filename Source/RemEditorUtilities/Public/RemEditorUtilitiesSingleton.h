@@ -0,0 +1,50 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "Templates/UniquePtr.h"
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief Base of editor singletons, made on first Get() on game thread, destroyed by Shutdown() on module shutdown.
+ * The derived class befriends this base to keep its constructor private, and is exported by its module,
+ * which exports this base along with it, so every module shares the one instance
+ */
+template <typename T>
+class TEditorSingleton : public FNoncopyable
+{
+    inline static TUniquePtr<T> Instance;
+
+public:
+    static T& Get()
+    {
+        check(IsInGameThread());
+
+        if (!Instance)
+        {
+            Instance.Reset(new T);
+        }
+
+        return *Instance;
+    }
+
+    /**
+     * @return the instance, nullptr if it's not made yet or already shut down
+     */
+    static T* TryGet()
+    {
+        return Instance.Get();
+    }
+
+    /**
+     * @brief Destroy the instance, called on module shutdown
+     */
+    static void Shutdown()
+    {
+        Instance.Reset();
+    }
+};
+
+}
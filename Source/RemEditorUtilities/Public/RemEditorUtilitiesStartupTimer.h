@@ -0,0 +1,30 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+class FOutputDevice;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief Measure a startup step of the plugin modules, shown in insights, logged and kept for
+ * "Rem.Editor.StartupTimes". A warning is logged when a step takes longer than "Rem.Editor.StartupBudgetMs"
+ */
+class REMEDITORUTILITIES_API FScopedStartupTimer : public FNoncopyable
+{
+    /** kept by name, the string of the caller is gone once its module unloads */
+    FName StepName;
+    double StartTime;
+
+public:
+    explicit FScopedStartupTimer(const TCHAR* InStepName);
+    ~FScopedStartupTimer();
+};
+
+/**
+ * @brief Print every step measured by FScopedStartupTimer, and the total
+ */
+REMEDITORUTILITIES_API void DumpStartupTimes(FOutputDevice& Ar);
+
+}
@@ -0,0 +1,10 @@
+﻿// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "HAL/LowLevelMemTracker.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("RemEditorUtilities"), STATGROUP_RemEditorUtilities, STATCAT_Advanced);
+
+LLM_DECLARE_TAG_API(RemEditorUtilities, REMEDITORUTILITIES_API);
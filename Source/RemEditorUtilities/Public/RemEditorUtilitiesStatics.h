@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "RemEditorUtilitiesGenerationPass.h"
+#include "Containers/ArrayView.h"
 #include "Enum/RemContainerCombination.h"
 #include "Math/Vector4.h"
 
@@ -11,6 +13,8 @@ class IPropertyHandle;
 class IAssetEditorInstance;
 class UWidget;
 class SWidget;
+class FObjectPropertyBase;
+struct FSoftObjectPath;
 template <class T>
 struct TSoftObjectPtr;
 
@@ -30,8 +34,22 @@ REMEDITORUTILITIES_API extern const FVector4f PropertyPadding;
 
 REMEDITORUTILITIES_API FText GetWidgetName(const UWidget* Widget);
 REMEDITORUTILITIES_API FText GetWidgetName(const TSoftObjectPtr<const UWidget>& Widget);
+/**
+ * @brief Get widget name from its soft path without resolving it
+ * @param WidgetPath soft path of the widget
+ * @return the last element of the sub path, eg: "Button_1" of "/Game/WBP.WBP:WidgetTree.Button_1"
+ */
+REMEDITORUTILITIES_API FName GetWidgetNameFromPath(const FSoftObjectPath& WidgetPath);
+
 REMEDITORUTILITIES_API bool IsInstancedStruct(const UScriptStruct* Struct);
 
+/**
+ * @brief Make the group name of a container element with IndexFormat, without any heap allocated string
+ * @param Index index of the element in container
+ * @return eg: "Index [ 0 ]"
+ */
+REMEDITORUTILITIES_API FName MakeIndexGroupName(int32 Index);
+
 /**
  * @brief A valid array element property handle would have children num equal to 1
  * @param ElementHandle an array element property handle
@@ -56,7 +74,8 @@ REMEDITORUTILITIES_API bool IsContainerElementValid(const TSharedRef<IPropertyHa
  *	the relation between group A, B, C should be "The former is the parent of the latter", in that way, they could be
  *	correctly (hierarchically) displayed in editor.
  *
- *	Pointer of GroupC would be returned
+ *	Pointer of GroupC would be returned.
+ *	The groups are laid out by MakePropertyLayoutGroups and applied right away
  * 
  * @param ChildGroupLayerMapping layered group name to IDetailGroup mapping.
  * Note it must contain the "start point (no category group)" --- "ChildGroupLayerMapping[0][NAME_None]" element
@@ -66,13 +85,15 @@ REMEDITORUTILITIES_API bool IsContainerElementValid(const TSharedRef<IPropertyHa
  * @return the IDetailGroup pointer of given PropertyGroupName, so you could "AddPropertyRow" under it.
  * ChildGroupLayerMapping would be properly populated
  */
-REMEDITORUTILITIES_API IDetailGroup* MakePropertyGroups(TArray<TMap<FName, IDetailGroup*>>& ChildGroupLayerMapping,
+REMEDITORUTILITIES_API IDetailGroup* MakePropertyGroups(FChildGroupLayerMapping& ChildGroupLayerMapping,
     const FName PropertyGroupName);
 
 using FMakePropertyWidgetFunctor = TFunctionRef<TSharedRef<SWidget>(TSharedRef<IPropertyHandle> PropertyHandle)>;
 
 /**
- * @brief Make a custom widget for the property no matter whether if it is a container
+ * @brief Make a custom widget for the property no matter whether if it is a container.
+ * The functor gets the property handle, so its widgets can't be rebound and are never pooled, customizations owning a
+ * FPooledWidgetOwner should use MakePooledCustomWidgetForProperty instead
  * @param PropertyHandle handle of the property to customize
  * @param DetailPropertyRow the row to put our custom widget in
  * @param ContainerType container type of the Property
@@ -83,12 +104,65 @@ REMEDITORUTILITIES_API void MakeCustomWidgetForProperty(const TSharedRef<IProper
     FMakePropertyWidgetFunctor Functor);
 
 /**
- * @brief Make a property path used for query property handle (using property path name)
+ * @brief Put the widget in a slot with property padding, as the parts of custom rows are
+ */
+REMEDITORUTILITIES_API TSharedRef<SWidget> WrapPropertyWidget(const TSharedRef<SWidget>& Content);
+
+/**
+ * @brief Row layout of MakeCustomWidgetForProperty and MakePooledCustomWidgetForProperty
+ * @param MakeFunctorWidget make the (wrapped) widget of the parts customized by the functor
+ */
+REMEDITORUTILITIES_API void MakeCustomWidgetLayout(const TSharedRef<IPropertyHandle>& PropertyHandle,
+    FDetailWidgetRow& DetailPropertyRow, Enum::EContainerCombination ContainerType,
+    FMakePropertyWidgetFunctor MakeFunctorWidget);
+
+/**
+ * @brief Make a property path used for query property handle (using property path name).
+ * Allocates the string on every call, prefer GetPropertyPathName
  * @param Property 
  * @return 
  */
 REMEDITORUTILITIES_API FString GetPropertyPath(const FProperty* Property);
 
+/**
+ * @brief Interned GetPropertyPath, allocates nothing once the path is cached, @see FPropertyPathCache
+ * @return path of the property, NAME_None if the property is null or has no owner object
+ */
+REMEDITORUTILITIES_API FName GetPropertyPathName(const FProperty* Property);
+
+/**
+ * @brief Resolve handles of many property paths in one walk of the handle tree, instead of a GetChildHandle chain per
+ * path: the paths are merged into a prefix trie, and children of every handle on the way are scanned only once
+ * @param RootHandle handle the paths are relative to
+ * @param PropertyPaths member names separated by ".", eg: "FunctionData.FunctionName",
+ * or a single member name, as GetPropertyPathName makes for struct members
+ * @return handle of every path found
+ */
+REMEDITORUTILITIES_API TMap<FName, TSharedRef<IPropertyHandle>> ResolveChildHandles(
+    const TSharedRef<IPropertyHandle>& RootHandle, TConstArrayView<FName> PropertyPaths);
+
+/**
+ * @brief Whether the property value differs between selected objects, compared with Identical instead of exported text
+ * @param Property property of the values
+ * @param ValuePtrs value pointers of all selected objects, @see GetValuePtrs
+ * @return true if there is more than one distinct value
+ */
+REMEDITORUTILITIES_API bool HasMultipleValues(const FProperty& Property, TConstArrayView<void*> ValuePtrs);
+
+/**
+ * @brief Get the soft object path of an object property value without resolving or loading it
+ * @param ObjectProperty any FObjectPropertyBase, including soft object property
+ * @param ValuePtr pointer to the property value
+ * @return soft object path of the value
+ */
+REMEDITORUTILITIES_API FSoftObjectPath GetSoftObjectPath(const FObjectPropertyBase& ObjectProperty,
+    const void* ValuePtr);
+
+/**
+ * @return whether combo button pickers keep their popup content alive across opens, @see TPersistentPopupContent
+ */
+REMEDITORUTILITIES_API bool IsPersistentPopupContentEnabled();
+
 REMEDITORUTILITIES_API FText TryGetText(const FPropertyAccess::Result Result,
     const TFunctionRef<FText()>& Predicate);
 }
@@ -3,6 +3,10 @@
 #pragma once
 
 #include "RemEditorUtilitiesStatics.h"
+#include "RemEditorUtilitiesAssetEditorCache.h"
+#include "RemEditorUtilitiesGenerationPass.h"
+#include "RemEditorUtilitiesPropertyCustomization.h"
+#include "RemEditorUtilitiesPropertyVisitor.h"
 #include "Enum/RemContainerCombination.h"
 
 #include "Editor.h"
@@ -19,30 +23,124 @@
 
 namespace Rem::Editor
 {
+/**
+ * @brief Get the opened asset editor of the blueprint generating the class, @see FAssetEditorInstanceCache
+ * @tparam T type of the asset editor
+ * @param Class blueprint generated class
+ * @return the asset editor, nullptr if it is not opened
+ */
 template <std::derived_from<IAssetEditorInstance> T>
 T* GetAssetEditorInstance(UClass* Class)
 {
-    auto* Blueprint = UBlueprint::GetBlueprintFromClass(Class);
-    RemCheckVariable(Blueprint, return {});
+    return static_cast<T*>(FAssetEditorInstanceCache::Get().Find(Class));
+}
+
+/**
+ * @brief Get value pointers of the property for all selected objects, without any text conversion
+ * @tparam ValueType type of the property value, it's up to the caller to make sure it matches the property
+ * @param PropertyHandle handle of the property
+ * @return one pointer per selected object, in the same order as the outer objects
+ */
+template <typename ValueType = void>
+TArray<ValueType*> GetValuePtrs(const TSharedRef<IPropertyHandle>& PropertyHandle)
+{
+    TArray<void*> RawData;
+    PropertyHandle->AccessRawData(RawData);
+
+    if constexpr (std::is_void_v<ValueType>)
+    {
+        return RawData;
+    }
+    else
+    {
+        TArray<ValueType*> ValuePtrs;
+        ValuePtrs.Reserve(RawData.Num());
+        for (void* Data : RawData)
+        {
+            ValuePtrs.Add(static_cast<ValueType*>(Data));
+        }
+        return ValuePtrs;
+    }
+}
+
+/**
+ * @brief Read the object value of all selected objects
+ * @tparam ReturnType UObject pointer or TSoftObjectPtr
+ * @param ChildHandle handle of a FObjectPropertyBase property
+ * @param OutResult MultipleValues if selected objects have different values
+ * @return value of each selected object, empty if the property is not a FObjectPropertyBase
+ */
+template <typename ReturnType>
+TArray<ReturnType> GetCurrentValues(const TSharedRef<IPropertyHandle>& ChildHandle,
+    FPropertyAccess::Result& OutResult)
+{
+    const auto* ObjectProperty = CastField<FObjectPropertyBase>(ChildHandle->GetProperty());
+    const TArray<void*> ValuePtrs = GetValuePtrs(ChildHandle);
 
-    RemCheckVariable(GEditor, return {});
+    TArray<ReturnType> Values;
+    if (!ObjectProperty || ValuePtrs.IsEmpty() || ValuePtrs.Contains(nullptr))
+    {
+        OutResult = FPropertyAccess::Fail;
+        return Values;
+    }
 
-    auto* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-    RemCheckVariable(AssetEditorSubsystem, return {});
+    OutResult = HasMultipleValues(*ObjectProperty, ValuePtrs)
+                    ? FPropertyAccess::MultipleValues
+                    : FPropertyAccess::Success;
 
-    if (auto* AssetEditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+    Values.Reserve(ValuePtrs.Num());
+    for (const void* ValuePtr : ValuePtrs)
     {
-        auto* Editor = static_cast<T*>(AssetEditorInstance);
-        return Editor;
+        using RawType = std::remove_pointer_t<ReturnType>;
+        if constexpr (CInstanceOf<ReturnType, TSoftObjectPtr>)
+        {
+            Values.Add(ReturnType(GetSoftObjectPath(*ObjectProperty, ValuePtr)));
+        }
+        else if constexpr (std::derived_from<RawType, UObject>)
+        {
+            Values.Add(Cast<RawType>(ObjectProperty->GetObjectPropertyValue(ValuePtr)));
+        }
     }
 
-    return nullptr;
+    return Values;
 }
 
+/**
+ * @brief Read the value of the first selected object
+ * @tparam ReturnType UObject pointer or TSoftObjectPtr
+ * @param ChildHandle handle of the property
+ * @param OutResult Success even if selected objects have different values, like IPropertyHandle::GetPerObjectValues,
+ * use GetCurrentValues to tell them apart
+ * @return the value of the first selected object
+ */
 template <typename ReturnType>
 ReturnType GetCurrentValue(const TSharedRef<IPropertyHandle> ChildHandle,
     FPropertyAccess::Result& OutResult)
 {
+    using RawType = std::remove_pointer_t<ReturnType>;
+
+    if (const auto* ObjectProperty = CastField<FObjectPropertyBase>(ChildHandle->GetProperty()))
+    {
+        const TArray<void*> ValuePtrs = GetValuePtrs(ChildHandle);
+        if (ValuePtrs.IsEmpty() || ValuePtrs.Contains(nullptr))
+        {
+            OutResult = FPropertyAccess::Fail;
+            return ReturnType{};
+        }
+
+        OutResult = FPropertyAccess::Success;
+
+        if constexpr (CInstanceOf<ReturnType, TSoftObjectPtr>)
+        {
+            return ReturnType(GetSoftObjectPath(*ObjectProperty, ValuePtrs[0]));
+        }
+        else if constexpr (std::derived_from<RawType, UObject>)
+        {
+            return Cast<RawType>(ObjectProperty->GetObjectPropertyValue(ValuePtrs[0]));
+        }
+    }
+
+    // not an object property, fallback to text conversion
     switch (TArray<FString> PerObjectValues;
         OutResult = ChildHandle->GetPerObjectValues(PerObjectValues))
     {
@@ -50,7 +148,6 @@ ReturnType GetCurrentValue(const TSharedRef<IPropertyHandle> ChildHandle,
         {
             if (PerObjectValues.Num() > 0)
             {
-                using RawType = std::remove_pointer_t<ReturnType>;
                 if constexpr (CInstanceOf<ReturnType, TSoftObjectPtr>)
                 {
                     return ReturnType(FSoftObjectPath{PerObjectValues[0]});
@@ -79,13 +176,11 @@ ReturnType GetCurrentValue(const TSharedRef<IPropertyHandle>& ChildHandle)
 template <typename ObjectType>
 bool SetObjectValue(const ObjectType* Object, const TSharedRef<IPropertyHandle>& PropertyHandle)
 {
+    // using soft object to get the object path string, it is the same for all selected objects
+    const TSoftObjectPtr<const ObjectType> SoftObject(Object);
+
     TArray<FString> References;
-    for (auto Index = 0; Index < PropertyHandle->GetNumPerObjectValues(); Index++)
-    {
-        // using soft object to get the object path string
-        TSoftObjectPtr<const ObjectType> SoftObject(Object);
-        References.Add(SoftObject.ToString());
-    }
+    References.Init(SoftObject.ToString(), PropertyHandle->GetNumPerObjectValues());
 
     // can't use this to set value from UWidgetBlueprintGeneratedClass::WidgetTree(of UClass property I guess),
     // PPF_ParsingDefaultProperties is needed but that is hard coded
@@ -102,7 +197,8 @@ bool SetObjectValue(const ObjectType* Object, const TSharedRef<IPropertyHandle>&
  * @tparam TGroupBuilder any type has "AddGroup" function to add a group
  * @param ContainerHandle property handle of the container
  * @param GroupBuilder group builder object reference
- * @param OnPropertyValueChanged optional call back when container value changed
+ * @param OnPropertyValueChanged optional call back when container value changed,
+ * @see MakeContainerLayoutRefresh to only refresh the content when its layout changed
  * @return the reference of  container element group
  */
 template <typename TGroupBuilder>
@@ -127,31 +223,10 @@ IDetailGroup& GenerateContainerHeader(const TSharedRef<IPropertyHandle>& Contain
     return ContainerGroup;
 }
 
-using FPropertyCustomizationFunctor =
-TFunctionRef<void(TSharedRef<IPropertyHandle> Handle, FDetailWidgetRow& WidgetPropertyRow,
-    Enum::EContainerCombination)>;
-
-// forward declaration
-template <CFObjectPropertyBase PropertyType, typename PropertyBaseClass>
-void GenerateWidgetForContainerElement(IDetailGroup& ParentGroup, const TSharedRef<IPropertyHandle>& ElementHandle,
-    const FPropertyCustomizationFunctor Predicate,
-    const Enum::EContainerCombination ContainerType);
-
-// forward declaration
-template <CFObjectPropertyBase PropertyType, typename PropertyBaseClass>
-void GenerateWidgetsForNestedElement(const TSharedRef<IPropertyHandle>& ElementHandle, const uint32 NumChildren,
-    TArray<TMap<FName, IDetailGroup*>>& ChildGroupLayerMapping, const uint32 Layer,
-    const FPropertyCustomizationFunctor Predicate,
-    const Enum::EContainerCombination ContainerType);
 /**
- * @brief Generate widget for container content (elements)
+ * @brief Generate widget for container content (elements), @see the non-template overload
  * @tparam PropertyType the property type you want to customize with
  * @tparam PropertyBaseClass property base class
- * @param ContainerHandle container property handle
- * @param ContainerGroup container group
- * @param Predicate property customization predicate
- * @param ContainerType container type of PropertyHandle.
- * use it to identify whether the PropertyHandle is the container itself or one of the child handle of the original container and its container type
  */
 template <CFObjectPropertyBase PropertyType, typename PropertyBaseClass>
 void GenerateWidgetForContainerContent(const TSharedRef<IPropertyHandle>& ContainerHandle,
@@ -160,48 +235,14 @@ void GenerateWidgetForContainerContent(const TSharedRef<IPropertyHandle>& Contai
     const FPropertyCustomizationFunctor Predicate,
     const Enum::EContainerCombination ContainerType)
 {
-    uint32 NumChildren;
-    ContainerHandle->GetNumChildren(NumChildren);
-
-    if (ContainerType != Enum::EContainerCombination::Struct)
-    {
-        // traverse the container
-        for (uint32 Index = 0; Index < NumChildren; ++Index)
-        {
-            const TSharedPtr<IPropertyHandle> ElementHandle = ContainerHandle->GetChildHandle(Index);
-            RemCheckCondition(ElementHandle.IsValid(), continue;);
-
-            // Generate widget for container element
-            Editor::GenerateWidgetForContainerElement<PropertyType, PropertyBaseClass>(
-                ContainerGroup, ElementHandle.ToSharedRef(), Predicate, ContainerType);
-        }
-    }
-    else
-    {
-        const FName StructTypeName = CastFieldChecked<FStructProperty>(ContainerHandle->GetProperty())->Struct->
-            GetFName();
-
-        // member of USTRUCT with no category specified will default to the category of "type name of the USTRUCT",
-        // so we add extra mapping here to redirect it
-        TArray<TMap<FName, IDetailGroup*>> ChildGroupLayerMapping{{{NAME_None, &ContainerGroup},
-                {StructTypeName, &ContainerGroup}
-            }
-        };
-
-        GenerateWidgetsForNestedElement<PropertyType, PropertyBaseClass>(ContainerHandle, NumChildren,
-            ChildGroupLayerMapping, 0, Predicate, ContainerType);
-    }
+    GenerateWidgetForContainerContent(ContainerHandle, ContainerGroup,
+        FPropertyCustomizationDescriptor::Make<PropertyType, PropertyBaseClass>(), Predicate, ContainerType);
 }
 
 /**
- * @brief Generate widget for a container element
+ * @brief Generate widget for a container element, @see the non-template overload
  * @tparam PropertyType the property type you want to customize with
  * @tparam PropertyBaseClass property base class
- * @param ParentGroup container group
- * @param ElementHandle element property handle
- * @param Predicate property customization predicate
- * @param ContainerType container type of PropertyHandle.
- * use it to identify whether the PropertyHandle is the container itself or one of the child handle of the original container and its container type
  */
 template <CFObjectPropertyBase PropertyType, typename PropertyBaseClass>
 void GenerateWidgetForContainerElement(IDetailGroup& ParentGroup, const TSharedRef<IPropertyHandle>& ElementHandle,
@@ -209,203 +250,39 @@ void GenerateWidgetForContainerElement(IDetailGroup& ParentGroup, const TSharedR
     const FPropertyCustomizationFunctor Predicate,
     const Enum::EContainerCombination ContainerType)
 {
-    // add index[] group
-    const FName ElementGroupName = *FString::Format(*IndexFormat, {ElementHandle->GetIndexInArray()});
-    IDetailGroup& ElementGroup   = ParentGroup.AddGroup(ElementGroupName, FText::FromName(ElementGroupName));
-
-    const auto* StructProperty = CastField<FStructProperty>(ElementHandle->GetProperty());
-
-    if (IDetailPropertyRow& ElementGroupPropertyRow = ElementGroup.HeaderProperty(ElementHandle);
-        ContainerType != Enum::EContainerCombination::ContainerItself && !StructProperty)
-    {
-        // generate widget for TMap / TSet / TArray element
-        FDetailWidgetRow& DetailWidgetRow = ElementGroupPropertyRow.CustomWidget();
-        Predicate(ElementHandle, DetailWidgetRow, ContainerType);
-        return;
-    }
-
-    // add element properties and groups
-
-    if (!IsContainerElementValid(ElementHandle))
-    {
-        // invalid element that don't have any children
-        return;
-    }
-
-    const auto ElementValueHandle = StructProperty
-                                        ? ElementHandle
-                                        : ElementHandle->GetChildHandle(0).ToSharedRef();
-    uint32 NumChildren;
-    ElementValueHandle->GetNumChildren(NumChildren);
-
-    if (NumChildren <= 0)
-    {
-        return;
-    }
-
-    using FNameToDetailGroupMap = TMap<FName, IDetailGroup*>;
-
-    TArray ChildGroupLayerMapping =
-        !!StructProperty
-            ? TArray{
-                // member of USTRUCT with no category specified will default to the category of "type name of the USTRUCT",
-                // so we add extra mapping here to redirect it
-                FNameToDetailGroupMap{{NAME_None, &ElementGroup}, {StructProperty->Struct->GetFName(), &ElementGroup}},
-            }
-            : TArray{
-                FNameToDetailGroupMap{{NAME_None, &ElementGroup}}
-            };
-
-    GenerateWidgetsForNestedElement<PropertyType, PropertyBaseClass>(ElementValueHandle, NumChildren,
-        ChildGroupLayerMapping, 0, Predicate, ContainerType);
+    GenerateWidgetForContainerElement(ParentGroup, ElementHandle,
+        FPropertyCustomizationDescriptor::Make<PropertyType, PropertyBaseClass>(), Predicate, ContainerType);
 }
 
 /**
- * @brief Generate widgets for nested element (properties of an array element)
+ * @brief Generate widgets for nested element (properties of an array element), @see the non-template overload
  * @tparam PropertyType the property type you want to customize with
  * @tparam PropertyBaseClass property base class
- * @param ElementHandle element property handle
- * @param NumChildren children num of element property handle
- * @param ChildGroupLayerMapping layered group name to IDetailGroup mapping.
- * Note it must contain the "start point (no category group)" --- "ChildGroupLayerMapping[0][NAME_None]" element
- * @param Layer Index of ChildGroupLayerMapping indicates which layer it should reside
- * @param Predicate property customization predicate
- * @param ContainerType container type of PropertyHandle.
- * use it to identify whether the PropertyHandle is the container itself or one of the child handle of the original container and its container type
  */
 template <CFObjectPropertyBase PropertyType, typename PropertyBaseClass>
 void GenerateWidgetsForNestedElement(const TSharedRef<IPropertyHandle>& ElementHandle, const uint32 NumChildren,
-    TArray<TMap<FName, IDetailGroup*>>& ChildGroupLayerMapping, const uint32 Layer,
+    FChildGroupLayerMapping& ChildGroupLayerMapping, const uint32 Layer,
     // ReSharper disable once CppPassValueParameterByConstReference
     const FPropertyCustomizationFunctor Predicate,
     const Enum::EContainerCombination ContainerType)
 {
-    for (uint32 Index = 0; Index < NumChildren; ++Index)
-    {
-        TSharedPtr<IPropertyHandle> ChildHandlePtr = ElementHandle->GetChildHandle(Index);
-        RemCheckCondition(ChildHandlePtr.IsValid(), continue;);
-
-        auto ChildHandle = ChildHandlePtr.ToSharedRef();
-
-        // if this child is a property
-        if (const auto* Property = ChildHandle->GetProperty())
-        {
-            const FName PropertyGroupName = FObjectEditorUtils::GetCategoryFName(ChildHandle->GetProperty());
-
-            IDetailGroup* PropertyGroup = MakePropertyGroups(ChildGroupLayerMapping, PropertyGroupName);
-
-            // PropertyGroup need to be valid from now on
-            RemCheckVariable(PropertyGroup, continue;);
-
-            const UStruct* Base = PropertyBaseClass::StaticClass();
-
-            auto bNeedCustomWidget = false;
-            if (const auto* ObjectPropertyBase = CastField<PropertyType>(Property))
-            {
-                if (ObjectPropertyBase->PropertyClass->IsChildOf(Base))
-                {
-                    bNeedCustomWidget = true;
-                }
-            }
-            else if (const auto* ArrayProperty = CastField<FArrayProperty>(Property))
-            {
-                if (Property::IsPropertyClassChildOf<PropertyType>(ArrayProperty->Inner, Base) || CastField<
-                        FStructProperty>(ArrayProperty->Inner))
-                {
-                    IDetailGroup& ContainerGroup = GenerateContainerHeader(ChildHandle, *PropertyGroup);
-                    GenerateWidgetForContainerContent<PropertyType, PropertyBaseClass>(ChildHandle, ContainerGroup,
-                        Predicate, Enum::EContainerCombination::Array);
-                    continue;
-                }
-            }
-            else if (const auto* MapProperty = CastField<FMapProperty>(Property))
-            {
-                if (const bool IsPropertyClassChildOfResult[2] =
-                    {
-                        Property::IsPropertyClassChildOf<PropertyType>(MapProperty->KeyProp, Base),
-                        // bMapKey
-                        Property::IsPropertyClassChildOf<PropertyType>(MapProperty->ValueProp, Base) || CastField<
-                            FStructProperty>(MapProperty->ValueProp) // bMapValue
-                    };
-                    IsPropertyClassChildOfResult[0] || IsPropertyClassChildOfResult[1])
-                {
-                    IDetailGroup& ContainerGroup = GenerateContainerHeader(ChildHandle, *PropertyGroup);
-
-                    Enum::EContainerCombination MapContainerType{};
-                    if (IsPropertyClassChildOfResult[0] && IsPropertyClassChildOfResult[1])
-                    {
-                        MapContainerType = Enum::EContainerCombination::Map;
-                    }
-                    else if (IsPropertyClassChildOfResult[0])
-                    {
-                        MapContainerType = Enum::EContainerCombination::MapKey;
-                    }
-                    else if (IsPropertyClassChildOfResult[1])
-                    {
-                        MapContainerType = Enum::EContainerCombination::MapValue;
-                    }
-
-                    GenerateWidgetForContainerContent<PropertyType, PropertyBaseClass>(ChildHandle, ContainerGroup,
-                        Predicate, MapContainerType);
-                    continue;
-                }
-            }
-            else if (const auto* SetProperty = CastField<FSetProperty>(Property))
-            {
-                if (Property::IsPropertyClassChildOf<PropertyType>(SetProperty->ElementProp, Base) || CastField<
-                        FStructProperty>(SetProperty->ElementProp))
-                {
-                    IDetailGroup& ContainerGroup = GenerateContainerHeader(ChildHandle, *PropertyGroup);
-                    GenerateWidgetForContainerContent<PropertyType, PropertyBaseClass>(ChildHandle, ContainerGroup,
-                        Predicate, Enum::EContainerCombination::Set);
-                    continue;
-                }
-            }
-            else if (const auto* StructProperty = CastField<FStructProperty>(Property);
-                StructProperty)
-            {
-                // skip instanced struct, or it can't show up in details panel
-                if (!IsInstancedStruct(StructProperty->Struct))
-                {
-                    IDetailGroup& ContainerGroup = GenerateContainerHeader(ChildHandle, *PropertyGroup);
-
-                    // TODO this will cause inner properties of customized struct type being shown up redundantly.
-                    // eg: FGameplayTag::TagName, we need a way to identify whether a struct type has a detail customization
-                    // FPropertyEditorModule::IsCustomizedStruct looks not exposed at the moment
-                    GenerateWidgetForContainerContent<PropertyType, PropertyBaseClass>(ChildHandle, ContainerGroup,
-                        Predicate, Enum::EContainerCombination::Struct);
-                    continue;
-                }
-            }
-
-            // add property row
-            IDetailPropertyRow& WidgetPropertyRow = PropertyGroup->AddPropertyRow(ChildHandle);
-            WidgetPropertyRow.EditCondition(ChildHandle->IsEditable(), {});
+    GenerateWidgetsForNestedElement(ElementHandle, NumChildren, ChildGroupLayerMapping, Layer,
+        FPropertyCustomizationDescriptor::Make<PropertyType, PropertyBaseClass>(), Predicate, ContainerType);
+}
 
-            if (bNeedCustomWidget)
-            {
-                Predicate(ChildHandle, WidgetPropertyRow.CustomWidget(), ContainerType);
-            }
-        }
-        // if this child is a category
-        else
-        {
-            // prevent duplicate adding on same layer but different category
-            if (ChildGroupLayerMapping.Num() <= static_cast<int32>(Layer + 1))
-            {
-                ChildGroupLayerMapping.AddDefaulted();
-            }
+/**
+ * @brief Get struct pointers of all selected objects
+ * @tparam StructType type of the struct property
+ * @param PropertyHandle handle of the struct property
+ * @return one pointer per selected object, empty if the property is not a StructType
+ */
+template <CHasStaticStruct StructType>
+TArray<StructType*> GetStructPtrs(const TSharedRef<IPropertyHandle>& PropertyHandle)
+{
+    const auto* StructProperty = CastField<FStructProperty>(PropertyHandle->GetProperty());
+    RemCheckCondition(StructProperty && StructProperty->Struct == StructType::StaticStruct(), return {};);
 
-            uint32 NumChildrenOfChildHandle;
-            ChildHandle->GetNumChildren(NumChildrenOfChildHandle);
-            if (NumChildrenOfChildHandle != 0)
-            {
-                // generate property group and nested property widgets
-                GenerateWidgetsForNestedElement<PropertyType, PropertyBaseClass>(ChildHandle, NumChildrenOfChildHandle,
-                    ChildGroupLayerMapping, Layer + 1, Predicate, ContainerType);
-            }
-        }
-    }
+    return GetValuePtrs<StructType>(PropertyHandle);
 }
 
 template <CHasStaticStruct StructType>
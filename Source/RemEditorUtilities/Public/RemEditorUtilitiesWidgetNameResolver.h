@@ -0,0 +1,85 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "UObject/SoftObjectPath.h"
+
+class UWidget;
+class UObject;
+template <class T>
+struct TSoftObjectPtr;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief Resolve display name of soft widget references without loading the widget blueprint synchronously.
+ * Loaded widgets are named live, unloaded ones get a provisional name derived from the soft path (checked against
+ * asset registry) or the widget tree of the loaded owner, cached by soft path until the owning asset gets loaded,
+ * renamed or removed. Entries are grouped by owning package, so each asset load is a single lookup.
+ * With "Rem.Editor.WidgetName.AsyncLoad" on, the owning package is loaded asynchronously and the name refreshed
+ */
+class REMEDITORUTILITIES_API FWidgetNameResolver : public TEditorCacheSingleton<FWidgetNameResolver>
+{
+    enum class EEntryState : uint8
+    {
+        /** provisional name, the owning package could be loaded asynchronously */
+        Unresolved,
+        /** async load of the owning package is in flight */
+        Loading,
+        /** named from the widget tree of the loaded owner */
+        Resolved,
+        /** the owning asset doesn't exist, never load it */
+        Missing,
+    };
+
+    struct FEntry
+    {
+        FText Name;
+        EEntryState State{};
+    };
+
+    using FPackageEntries = TMap<FSoftObjectPath, FEntry>;
+
+    /** by long package name of the owning asset, so a loaded package drops its entries in one lookup */
+    TMap<FName, FPackageEntries> UnresolvedEntries;
+    FSimpleMulticastDelegate OnNameResolvedDelegate;
+    FDelegateHandle OnAssetLoadedHandle;
+
+    friend TEditorSingleton<FWidgetNameResolver>;
+
+    FWidgetNameResolver();
+
+public:
+    ~FWidgetNameResolver();
+
+    /**
+     * @brief Get display name of the widget, never loads it synchronously
+     * @param Widget soft reference of the widget
+     * @return name of the widget, or a provisional name derived from the soft path if it is not loaded
+     */
+    FText Resolve(const TSoftObjectPtr<const UWidget>& Widget);
+
+    /**
+     * @brief Drop all cached provisional names
+     */
+    void Reset();
+
+    /**
+     * @brief Broadcast when a provisional name is replaced by the name of the loaded widget,
+     * eg: invalidate widgets showing the name
+     */
+    FSimpleMulticastDelegate& OnNameResolved()
+    {
+        return OnNameResolvedDelegate;
+    }
+
+private:
+    FEntry MakeEntry(const FSoftObjectPath& WidgetPath) const;
+    void RequestAsyncLoad(FName PackageName, FPackageEntries& PackageEntries);
+    void ResolvePackage(FName PackageName);
+    void OnAssetLoaded(UObject* Asset);
+};
+
+}
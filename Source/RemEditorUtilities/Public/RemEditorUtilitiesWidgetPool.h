@@ -0,0 +1,175 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "Containers/Ticker.h"
+#include "Enum/RemContainerCombination.h"
+#include "Templates/SharedPointer.h"
+
+class FDetailWidgetRow;
+class IPropertyHandle;
+class IPropertyTypeCustomization;
+class SWidget;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief What a pooled widget is currently showing, rebound every time the widget is reused.
+ * Widgets made for the pool must read the property handle (and the customization) through it, never capture them
+ */
+class REMEDITORUTILITIES_API FPropertyWidgetBinding
+{
+    TSharedPtr<IPropertyHandle> PropertyHandle;
+    TWeakPtr<IPropertyTypeCustomization> Customization;
+
+public:
+    void Bind(const TSharedRef<IPropertyHandle>& InPropertyHandle,
+        const TWeakPtr<IPropertyTypeCustomization>& InCustomization);
+
+    /**
+     * @brief Let go of the property handle while the widget is free
+     */
+    void Unbind();
+
+    const TSharedPtr<IPropertyHandle>& GetPropertyHandle() const
+    {
+        return PropertyHandle;
+    }
+
+    /**
+     * @return the customization making the row, null if it is gone
+     */
+    template <typename CustomizationType>
+    TSharedPtr<CustomizationType> GetCustomization() const
+    {
+        return StaticCastSharedPtr<CustomizationType>(Customization.Pin());
+    }
+};
+
+using FMakeBoundPropertyWidgetFunctor =
+TFunctionRef<TSharedRef<SWidget>(const TSharedRef<FPropertyWidgetBinding>& Binding)>;
+
+class FPooledWidgetOwner;
+
+/**
+ * @brief Reusable custom row widgets keyed by container type and functor key. Widgets in use are leased to a
+ * FPooledWidgetOwner, and put back to the free list of their key when it is destroyed (with the customization
+ * owning it). Reused widgets are rebound to the new property handle instead of being reconstructed.
+ * Free widgets unused for a while are trimmed, and those still in a row of the old details view are skipped.
+ * Only rows made with a binding functor can be pooled, MakeCustomWidgetForProperty is never pooled
+ * Controlled by "Rem.Editor.WidgetPool.Enabled", "Rem.Editor.WidgetPool.MaxPerKey" and
+ * "Rem.Editor.WidgetPool.TrimSeconds"
+ */
+class REMEDITORUTILITIES_API FPropertyWidgetPool : public TEditorCacheSingleton<FPropertyWidgetPool>
+{
+public:
+    struct FPoolKey
+    {
+        Enum::EContainerCombination ContainerType{};
+        FName FunctorKey;
+
+        bool operator==(const FPoolKey& Other) const
+        {
+            return ContainerType == Other.ContainerType && FunctorKey == Other.FunctorKey;
+        }
+
+        friend uint32 GetTypeHash(const FPoolKey& Key)
+        {
+            return HashCombineFast(::GetTypeHash(Key.ContainerType), GetTypeHash(Key.FunctorKey));
+        }
+    };
+
+    struct FPooledWidget
+    {
+        TSharedRef<SWidget> Widget;
+        TSharedRef<FPropertyWidgetBinding> Binding;
+    };
+
+private:
+    struct FFreeWidget
+    {
+        FPooledWidget PooledWidget;
+
+        /** FPlatformTime::Seconds when it was released */
+        double ReleaseTime{};
+    };
+
+    struct FKeyPool
+    {
+        /** most recently released last */
+        TArray<FFreeWidget> FreeWidgets;
+        int32 NumInUse{};
+    };
+
+    TMap<FPoolKey, FKeyPool> Pools;
+
+    FTSTicker::FDelegateHandle TrimTickerHandle;
+
+    friend TEditorSingleton<FPropertyWidgetPool>;
+
+    FPropertyWidgetPool();
+
+public:
+    ~FPropertyWidgetPool();
+
+    /**
+     * @brief Take a free widget of the key and rebind it, or make a new one with the functor
+     * @param ContainerType container type of the property
+     * @param FunctorKey identity of the functor, widgets made by different functors must use different keys
+     * @param PropertyHandle the property handle to bind
+     * @param Customization the customization making the row
+     * @param Owner the widget is leased to, until it is destroyed
+     * @param Functor make the widget, only called when there is no free widget of the key
+     */
+    TSharedRef<SWidget> Acquire(Enum::EContainerCombination ContainerType, FName FunctorKey,
+        const TSharedRef<IPropertyHandle>& PropertyHandle,
+        const TWeakPtr<IPropertyTypeCustomization>& Customization, FPooledWidgetOwner& Owner,
+        FMakeBoundPropertyWidgetFunctor Functor);
+
+    /**
+     * @brief Put leased widgets back to free lists, safe to call after the pool is shut down
+     */
+    static void Release(TArray<TPair<FPoolKey, FPooledWidget>>& Leases);
+
+    /**
+     * @brief Drop all free widgets, widgets in use are not affected
+     */
+    void Reset();
+
+private:
+    bool Trim(float DeltaTime);
+};
+
+/**
+ * @brief Widgets leased from FPropertyWidgetPool, owned by the customization making the rows, so the widgets are
+ * free again once the details view drops the customization
+ */
+class REMEDITORUTILITIES_API FPooledWidgetOwner : public FNoncopyable
+{
+    friend FPropertyWidgetPool;
+
+    TArray<TPair<FPropertyWidgetPool::FPoolKey, FPropertyWidgetPool::FPooledWidget>> Leases;
+
+public:
+    FPooledWidgetOwner() = default;
+    ~FPooledWidgetOwner();
+};
+
+/**
+ * @brief Pooled version of MakeCustomWidgetForProperty, @see FPropertyWidgetPool
+ * @param PropertyHandle handle of the property to customize
+ * @param DetailPropertyRow the row to put our custom widget in
+ * @param ContainerType container type of the Property
+ * @param FunctorKey identity of the functor
+ * @param Functor functor to make custom widget, reading the property handle through the binding
+ * @param Owner the widgets are leased to, usually a member of the customization
+ * @param Customization the customization making the row, accessible from the binding
+ */
+REMEDITORUTILITIES_API void MakePooledCustomWidgetForProperty(const TSharedRef<IPropertyHandle>& PropertyHandle,
+    FDetailWidgetRow& DetailPropertyRow, Enum::EContainerCombination ContainerType, FName FunctorKey,
+    FMakeBoundPropertyWidgetFunctor Functor, FPooledWidgetOwner& Owner,
+    const TWeakPtr<IPropertyTypeCustomization>& Customization = {});
+
+}
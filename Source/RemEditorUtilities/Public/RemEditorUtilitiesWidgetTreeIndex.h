@@ -0,0 +1,89 @@
+// Copyright RemRemRemRe, All Rights Reserved.
+
+#pragma once
+
+#include "RemEditorUtilitiesCacheSingleton.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UBlueprint;
+class UClass;
+class UWidget;
+class UWidgetBlueprint;
+
+namespace Rem::Editor
+{
+
+/**
+ * @brief Lookup tables of all widgets in the widget tree of a widget blueprint
+ */
+struct REMEDITORUTILITIES_API FWidgetTreeIndex
+{
+    /** keyed by widget identity, so entries of another widget taking over the name (or path) are told apart */
+    TMap<FName, TObjectKey<UWidget>> WidgetsByName;
+    TMap<FSoftObjectPath, TObjectKey<UWidget>> WidgetsByPath;
+    TMap<TObjectKey<UClass>, TArray<TWeakObjectPtr<UWidget>>> WidgetsByClass;
+
+    struct FIndexedWidget
+    {
+        FName Name;
+        FSoftObjectPath Path;
+        TObjectKey<UClass> Class;
+
+        /** UpdateCount of the last update which found the widget in the tree */
+        uint32 LastSeenUpdate{};
+    };
+
+    /** keys of each indexed widget, to find out what is renamed or removed when the tree changes */
+    TMap<TObjectKey<UWidget>, FIndexedWidget> IndexedWidgets;
+
+    FDelegateHandle OnChangedHandle;
+    FDelegateHandle OnCompiledHandle;
+    uint32 UpdateCount{};
+    bool bDirty{true};
+};
+
+/**
+ * @brief Per widget blueprint index of its widget tree, built on first lookup, and updated on next lookup after the
+ * blueprint changed or compiled. The change notifications don't tell which widgets changed, so every update walks the
+ * whole widget tree again, O(N) in the number of widgets, "incremental" only means the maps are diffed against the
+ * walk: entries of unchanged widgets are kept, only added, renamed and removed widgets are touched
+ */
+class REMEDITORUTILITIES_API FWidgetTreeIndexService : public TEditorCacheSingleton<FWidgetTreeIndexService>
+{
+    TMap<TObjectKey<UWidgetBlueprint>, FWidgetTreeIndex> Indices;
+
+    friend TEditorSingleton<FWidgetTreeIndexService>;
+
+    FWidgetTreeIndexService();
+
+public:
+    using ThisClass = FWidgetTreeIndexService;
+
+    ~FWidgetTreeIndexService();
+
+    const UWidget* FindWidgetByName(const UWidgetBlueprint* WidgetBlueprint, FName WidgetName);
+
+    /**
+     * @brief Find a widget by its object path, the owning widget blueprint is resolved from the path,
+     * but never loaded
+     * @param WidgetPath soft path of the widget, either in the widget tree of the blueprint or its generated class
+     * @return the widget, nullptr if the blueprint is not loaded or the widget is not found
+     */
+    const UWidget* FindWidgetByPath(const FSoftObjectPath& WidgetPath);
+
+    /**
+     * @brief Find all widgets of the class (including child classes' instances)
+     */
+    TArray<const UWidget*> FindWidgetsByClass(const UWidgetBlueprint* WidgetBlueprint, const UClass* WidgetClass);
+
+    void Reset();
+
+private:
+    FWidgetTreeIndex* GetIndex(const UWidgetBlueprint* WidgetBlueprint);
+    void UpdateIndex(const UWidgetBlueprint& WidgetBlueprint, FWidgetTreeIndex& Index) const;
+    void OnBlueprintChanged(UBlueprint* Blueprint);
+};
+
+}
@@ -18,8 +18,12 @@ public class RemEditorUtilities : ModuleRules
 				"Slate",
 				"SlateCore",
 				"UnrealEd",
+				"PropertyEditor",
 				"UMG",
+				"UMGEditor",
+				"AssetRegistry",
 				"ClassViewer",
+				"StructUtilsEditor",
 				
 				"RemCommon",
 			]